@@ -55,9 +55,18 @@ typedef struct _mp_obj_task_t {
     mp_obj_t ph_key;
 } mp_obj_task_t;
 
+// CIRCUITPY-CHANGE
+#if MICROPY_PY_ASYNCIO_TIMER_WHEEL
+typedef struct _task_wheel_t task_wheel_t;
+#endif
+
 typedef struct _mp_obj_task_queue_t {
     mp_obj_base_t base;
     mp_obj_task_t *heap;
+    // CIRCUITPY-CHANGE
+    #if MICROPY_PY_ASYNCIO_TIMER_WHEEL
+    task_wheel_t *wheel;
+    #endif
     #if MICROPY_PY_ASYNCIO_TASK_QUEUE_PUSH_CALLBACK
     mp_obj_t push_callback;
     #endif
@@ -103,6 +112,161 @@ static int task_lt(mp_pairheap_t *n1, mp_pairheap_t *n2) {
     return MP_OBJ_SMALL_INT_VALUE(ticks_diff(t1->ph_key, t2->ph_key)) < 0;
 }
 
+/******************************************************************************/
+// CIRCUITPY-CHANGE: Timer wheel for tasks with near deadlines
+
+#if MICROPY_PY_ASYNCIO_TIMER_WHEEL
+
+// A slot on level 0 covers 1ms, on level 1 32ms and on level 2 1024ms, so
+// deadlines up to about 32 seconds ahead can go in the wheel.
+#define TASK_WHEEL_LEVEL_BITS (5)
+#define TASK_WHEEL_SLOTS (1 << TASK_WHEEL_LEVEL_BITS)
+#define TASK_WHEEL_LEVELS (3)
+
+// Level n holds the tasks due at or after the cursor that are in the same level
+// n + 1 block as the cursor, but (for n > 0) not in the same level n block.  So
+// the lowest occupied slot of the lowest occupied level holds the next tasks
+// due, and on level 0 those all have the same deadline.  Each slot is a
+// circular list linked through the pairheap next field, and points at its last
+// task so that tasks with the same deadline come out in the order pushed.
+struct _task_wheel_t {
+    mp_uint_t cursor;
+    uint32_t occupied[TASK_WHEEL_LEVELS];
+    mp_obj_task_t *slot[TASK_WHEEL_LEVELS][TASK_WHEEL_SLOTS];
+};
+
+// A task in the wheel has no children in the heap, so child_last is free to
+// record which wheel it is in.
+#define TASK_IN_WHEEL(wheel, task) ((task)->pairheap.child_last == (mp_pairheap_t *)(wheel))
+
+static bool task_wheel_is_empty(task_wheel_t *wheel) {
+    for (size_t level = 0; level < TASK_WHEEL_LEVELS; ++level) {
+        if (wheel->occupied[level] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Returns the level a task due at or after the cursor belongs on, or
+// TASK_WHEEL_LEVELS if it is too far ahead for the wheel.
+static size_t task_wheel_level(task_wheel_t *wheel, mp_uint_t key) {
+    size_t level = 0;
+    while (level < TASK_WHEEL_LEVELS) {
+        size_t shift = (level + 1) * TASK_WHEEL_LEVEL_BITS;
+        if ((key >> shift) == (wheel->cursor >> shift)) {
+            break;
+        }
+        ++level;
+    }
+    return level;
+}
+
+static size_t task_wheel_index(mp_uint_t key, size_t level) {
+    return (key >> (level * TASK_WHEEL_LEVEL_BITS)) & (TASK_WHEEL_SLOTS - 1);
+}
+
+static void task_wheel_insert(task_wheel_t *wheel, mp_obj_task_t *task) {
+    mp_uint_t key = MP_OBJ_SMALL_INT_VALUE(task->ph_key);
+    size_t level = task_wheel_level(wheel, key);
+    size_t idx = task_wheel_index(key, level);
+    mp_obj_task_t *last = wheel->slot[level][idx];
+    if (last == NULL) {
+        task->pairheap.next = &task->pairheap;
+        wheel->occupied[level] |= 1u << idx;
+    } else {
+        task->pairheap.next = last->pairheap.next;
+        last->pairheap.next = &task->pairheap;
+    }
+    wheel->slot[level][idx] = task;
+    task->pairheap.child_last = (mp_pairheap_t *)wheel;
+}
+
+// Put the task in the wheel if its deadline is near enough, else return false.
+static bool task_wheel_push(task_wheel_t *wheel, mp_obj_task_t *task) {
+    if (task_wheel_is_empty(wheel)) {
+        wheel->cursor = MP_OBJ_SMALL_INT_VALUE(ticks());
+    }
+    if (ticks_diff(task->ph_key, MP_OBJ_NEW_SMALL_INT(wheel->cursor)) < 0
+        || task_wheel_level(wheel, MP_OBJ_SMALL_INT_VALUE(task->ph_key)) == TASK_WHEEL_LEVELS) {
+        return false;
+    }
+    task_wheel_insert(wheel, task);
+    return true;
+}
+
+// Return the next task due in the wheel, or NULL if it is empty.  When level 0
+// is empty this moves the cursor up to the next occupied block and spreads the
+// tasks in that block over the levels below it.
+static mp_obj_task_t *task_wheel_peek(task_wheel_t *wheel) {
+    for (;;) {
+        if (wheel->occupied[0] != 0) {
+            mp_obj_task_t *last = wheel->slot[0][mp_ctz(wheel->occupied[0])];
+            return (mp_obj_task_t *)last->pairheap.next;
+        }
+        size_t level = 1;
+        while (level < TASK_WHEEL_LEVELS && wheel->occupied[level] == 0) {
+            ++level;
+        }
+        if (level == TASK_WHEEL_LEVELS) {
+            return NULL;
+        }
+        size_t idx = mp_ctz(wheel->occupied[level]);
+        size_t shift = level * TASK_WHEEL_LEVEL_BITS;
+        wheel->cursor = (wheel->cursor & ~(((mp_uint_t)1 << (shift + TASK_WHEEL_LEVEL_BITS)) - 1))
+            | ((mp_uint_t)idx << shift);
+        mp_obj_task_t *last = wheel->slot[level][idx];
+        wheel->slot[level][idx] = NULL;
+        wheel->occupied[level] &= ~(1u << idx);
+        mp_pairheap_t *node = last->pairheap.next;
+        last->pairheap.next = NULL;
+        while (node != NULL) {
+            mp_obj_task_t *task = (mp_obj_task_t *)node;
+            node = node->next;
+            task_wheel_insert(wheel, task);
+        }
+    }
+}
+
+// Remove the task returned by the preceding task_wheel_peek.
+static void task_wheel_pop(task_wheel_t *wheel) {
+    size_t idx = mp_ctz(wheel->occupied[0]);
+    mp_obj_task_t *last = wheel->slot[0][idx];
+    mp_pairheap_t *head = last->pairheap.next;
+    if (head == &last->pairheap) {
+        wheel->slot[0][idx] = NULL;
+        wheel->occupied[0] &= ~(1u << idx);
+    } else {
+        last->pairheap.next = head->next;
+    }
+    head->next = NULL;
+    head->child_last = NULL;
+}
+
+static void task_wheel_remove(task_wheel_t *wheel, mp_obj_task_t *task) {
+    mp_uint_t key = MP_OBJ_SMALL_INT_VALUE(task->ph_key);
+    size_t level = task_wheel_level(wheel, key);
+    size_t idx = task_wheel_index(key, level);
+    mp_obj_task_t *last = wheel->slot[level][idx];
+    mp_pairheap_t *prev = &last->pairheap;
+    while (prev->next != &task->pairheap) {
+        prev = prev->next;
+    }
+    prev->next = task->pairheap.next;
+    if (task == last) {
+        if (prev == &task->pairheap) {
+            wheel->slot[level][idx] = NULL;
+            wheel->occupied[level] &= ~(1u << idx);
+        } else {
+            wheel->slot[level][idx] = (mp_obj_task_t *)prev;
+        }
+    }
+    task->pairheap.next = NULL;
+    task->pairheap.child_last = NULL;
+}
+
+#endif // MICROPY_PY_ASYNCIO_TIMER_WHEEL
+
 /******************************************************************************/
 // TaskQueue class
 
@@ -111,6 +275,10 @@ static mp_obj_t task_queue_make_new(const mp_obj_type_t *type, size_t n_args, si
     mp_arg_check_num(n_args, n_kw, 0, MICROPY_PY_ASYNCIO_TASK_QUEUE_PUSH_CALLBACK ? 1 : 0, false);
     mp_obj_task_queue_t *self = mp_obj_malloc(mp_obj_task_queue_t, type);
     self->heap = (mp_obj_task_t *)mp_pairheap_new(task_lt);
+    // CIRCUITPY-CHANGE
+    #if MICROPY_PY_ASYNCIO_TIMER_WHEEL
+    self->wheel = NULL;
+    #endif
     #if MICROPY_PY_ASYNCIO_TASK_QUEUE_PUSH_CALLBACK
     if (n_args == 1) {
         self->push_callback = args[0];
@@ -121,12 +289,29 @@ static mp_obj_t task_queue_make_new(const mp_obj_type_t *type, size_t n_args, si
     return MP_OBJ_FROM_PTR(self);
 }
 
+// CIRCUITPY-CHANGE: the next task due may be in the heap or the wheel
+static mp_obj_task_t *task_queue_head(mp_obj_task_queue_t *self) {
+    mp_obj_task_t *head = self->heap;
+    #if MICROPY_PY_ASYNCIO_TIMER_WHEEL
+    if (self->wheel != NULL) {
+        // On equal deadlines the heap goes first, as its task was pushed first.
+        mp_obj_task_t *first = task_wheel_peek(self->wheel);
+        if (first != NULL && (head == NULL || task_lt(&first->pairheap, &head->pairheap))) {
+            head = first;
+        }
+    }
+    #endif
+    return head;
+}
+
 static mp_obj_t task_queue_peek(mp_obj_t self_in) {
     mp_obj_task_queue_t *self = MP_OBJ_TO_PTR(self_in);
-    if (self->heap == NULL) {
+    // CIRCUITPY-CHANGE
+    mp_obj_task_t *head = task_queue_head(self);
+    if (head == NULL) {
         return mp_const_none;
     } else {
-        return MP_OBJ_FROM_PTR(self->heap);
+        return MP_OBJ_FROM_PTR(head);
     }
 }
 static MP_DEFINE_CONST_FUN_OBJ_1(task_queue_peek_obj, task_queue_peek);
@@ -141,7 +326,18 @@ static mp_obj_t task_queue_push(size_t n_args, const mp_obj_t *args) {
         assert(mp_obj_is_small_int(args[2]));
         task->ph_key = args[2];
     }
+    // CIRCUITPY-CHANGE
+    #if MICROPY_PY_ASYNCIO_TIMER_WHEEL
+    // Only queues that are given deadlines get a wheel, so wait queues stay small.
+    if (n_args == 3 && self->wheel == NULL) {
+        self->wheel = m_new0(task_wheel_t, 1);
+    }
+    if (self->wheel == NULL || !task_wheel_push(self->wheel, task)) {
+        self->heap = (mp_obj_task_t *)mp_pairheap_push(task_lt, TASK_PAIRHEAP(self->heap), TASK_PAIRHEAP(task));
+    }
+    #else
     self->heap = (mp_obj_task_t *)mp_pairheap_push(task_lt, TASK_PAIRHEAP(self->heap), TASK_PAIRHEAP(task));
+    #endif
     #if MICROPY_PY_ASYNCIO_TASK_QUEUE_PUSH_CALLBACK
     if (self->push_callback != MP_OBJ_NULL) {
         mp_call_function_1(self->push_callback, MP_OBJ_NEW_SMALL_INT(0));
@@ -153,10 +349,17 @@ static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(task_queue_push_obj, 2, 3, task_queue
 
 static mp_obj_t task_queue_pop(mp_obj_t self_in) {
     mp_obj_task_queue_t *self = MP_OBJ_TO_PTR(self_in);
-    mp_obj_task_t *head = (mp_obj_task_t *)mp_pairheap_peek(task_lt, &self->heap->pairheap);
+    // CIRCUITPY-CHANGE
+    mp_obj_task_t *head = task_queue_head(self);
     if (head == NULL) {
         mp_raise_msg(&mp_type_IndexError, MP_ERROR_TEXT("empty heap"));
     }
+    #if MICROPY_PY_ASYNCIO_TIMER_WHEEL
+    if (self->wheel != NULL && TASK_IN_WHEEL(self->wheel, head)) {
+        task_wheel_pop(self->wheel);
+        return MP_OBJ_FROM_PTR(head);
+    }
+    #endif
     self->heap = (mp_obj_task_t *)mp_pairheap_pop(task_lt, &self->heap->pairheap);
     return MP_OBJ_FROM_PTR(head);
 }
@@ -165,6 +368,13 @@ static MP_DEFINE_CONST_FUN_OBJ_1(task_queue_pop_obj, task_queue_pop);
 static mp_obj_t task_queue_remove(mp_obj_t self_in, mp_obj_t task_in) {
     mp_obj_task_queue_t *self = MP_OBJ_TO_PTR(self_in);
     mp_obj_task_t *task = MP_OBJ_TO_PTR(task_in);
+    // CIRCUITPY-CHANGE
+    #if MICROPY_PY_ASYNCIO_TIMER_WHEEL
+    if (self->wheel != NULL && TASK_IN_WHEEL(self->wheel, task)) {
+        task_wheel_remove(self->wheel, task);
+        return mp_const_none;
+    }
+    #endif
     self->heap = (mp_obj_task_t *)mp_pairheap_delete(task_lt, &self->heap->pairheap, &task->pairheap);
     return mp_const_none;
 }
@@ -197,6 +407,10 @@ static mp_obj_t task_make_new(const mp_obj_type_t *type, size_t n_args, size_t n
     mp_obj_task_t *self = m_new_obj(mp_obj_task_t);
     self->pairheap.base.type = type;
     mp_pairheap_init_node(task_lt, &self->pairheap);
+    // CIRCUITPY-CHANGE
+    #if MICROPY_PY_ASYNCIO_TIMER_WHEEL
+    self->pairheap.child_last = NULL;
+    #endif
     self->coro = args[0];
     self->data = mp_const_none;
     self->state = TASK_STATE_RUNNING_NOT_WAITED_ON;
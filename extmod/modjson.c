@@ -130,15 +130,28 @@ static MP_DEFINE_CONST_FUN_OBJ_1(mod_json_dumps_obj, mod_json_dumps);
 // strings).  It does 1 pass over the input stream.  It tries to be fast and
 // small in code size, while not using more RAM than necessary.
 
+// CIRCUITPY-CHANGE
+
+// Input is consumed from a buffer, which is refilled from the stream only when
+// it runs dry.  This keeps the per-character cost of the parser to a pointer
+// compare and increment.  For loads() the buffer is the input object itself.
+
+#ifndef CIRCUITPY_JSON_READ_CHUNK_SIZE
+#define CIRCUITPY_JSON_READ_CHUNK_SIZE 256
+#endif
+
 typedef struct _json_stream_t {
     mp_obj_t stream_obj;
+    // NULL for an in-memory buffer that is never refilled.
     mp_uint_t (*read)(mp_obj_t obj, void *buf, mp_uint_t size, int *errcode);
     int errcode;
     // CIRCUITPY-CHANGE
     mp_obj_t python_readinto[2 + 1];
     mp_obj_array_t bytearray_obj;
-    size_t start;
-    size_t end;
+    const byte *ptr;
+    const byte *end;
+    byte *buf;
+    mp_uint_t buf_size;
     byte cur;
 } json_stream_t;
 
@@ -147,15 +160,28 @@ typedef struct _json_stream_t {
 #define S_CUR(s) ((s).cur)
 #define S_NEXT(s) (json_stream_next(&(s)))
 
-static byte json_stream_next(json_stream_t *s) {
-    mp_uint_t ret = s->read(s->stream_obj, &s->cur, 1, &s->errcode);
-    // CIRCUITPY-CHANGE
-    JSON_DEBUG("  usjon_stream_next err:%2d cur: %c \n", s->errcode, s->cur);
-    if (s->errcode != 0) {
+// CIRCUITPY-CHANGE
+static MP_NOINLINE bool json_stream_fill(json_stream_t *s) {
+    if (s->read == NULL) {
+        return false;
+    }
+    s->errcode = 0;
+    mp_uint_t ret = s->read(s->stream_obj, s->buf, s->buf_size, &s->errcode);
+    JSON_DEBUG("  json_stream_fill err:%2d len:%d\n", s->errcode, (int)ret);
+    if (ret == MP_STREAM_ERROR) {
         mp_raise_OSError(s->errcode);
     }
-    if (ret == 0) {
+    s->ptr = s->buf;
+    s->end = s->buf + ret;
+    return ret != 0;
+}
+
+static inline byte json_stream_next(json_stream_t *s) {
+    // CIRCUITPY-CHANGE
+    if (s->ptr == s->end && !json_stream_fill(s)) {
         s->cur = S_EOF;
+    } else {
+        s->cur = *s->ptr++;
     }
     return s->cur;
 }
@@ -165,55 +191,51 @@ static byte json_stream_next(json_stream_t *s) {
 // We read from an object's `readinto` method in chunks larger than the json
 // parser needs to reduce the number of function calls done.
 
-#define CIRCUITPY_JSON_READ_CHUNK_SIZE 64
-
 static mp_uint_t json_python_readinto(mp_obj_t obj, void *buf, mp_uint_t size, int *errcode) {
-    (void)size;  // Ignore size because we know it's always 1.
+    (void)buf;  // Always the bytearray's storage.
+    (void)size;
     json_stream_t *s = obj;
-
-    if (s->start == s->end) {
-        *errcode = 0;
-        mp_obj_t ret = mp_call_method_n_kw(1, 0, s->python_readinto);
-        if (ret == mp_const_none) {
-            *errcode = MP_EAGAIN;
-            return MP_STREAM_ERROR;
-        }
-        s->start = 0;
-        s->end = mp_obj_get_int(ret);
-        if (s->end == 0) {
-            return 0;
-        }
+    mp_obj_t ret = mp_call_method_n_kw(1, 0, s->python_readinto);
+    if (ret == mp_const_none) {
+        *errcode = MP_EAGAIN;
+        return MP_STREAM_ERROR;
     }
+    return mp_obj_get_int(ret);
+}
+
+// CIRCUITPY-CHANGE
 
-    *((uint8_t *)buf) = ((uint8_t *)s->bytearray_obj.items)[s->start];
-    s->start++;
-    return 1;
+// Native streams are read a chunk at a time only if they can seek, so that the
+// read-ahead can be given back once the object is parsed.  Other streams such
+// as UARTs and sockets may have data after the JSON that belongs to the caller,
+// or may block waiting for bytes that never come, so they are read bytewise.
+
+static bool json_stream_can_seek(mp_obj_t stream_obj, const mp_stream_p_t *stream_p) {
+    if (stream_p->ioctl == NULL) {
+        return false;
+    }
+    int errcode;
+    return mp_stream_seek(stream_obj, 0, MP_SEEK_CUR, &errcode) != (mp_off_t)-1;
 }
 
-static mp_obj_t _mod_json_load(mp_obj_t stream_obj, bool return_first_json) {
-    const mp_stream_p_t *stream_p = mp_proto_get(0, stream_obj);
-    json_stream_t s;
-    uint8_t character_buffer[CIRCUITPY_JSON_READ_CHUNK_SIZE];
-    if (stream_p == NULL) {
-        s.start = 0;
-        s.end = 0;
-        mp_load_method(stream_obj, MP_QSTR_readinto, s.python_readinto);
-        s.bytearray_obj.base.type = &mp_type_bytearray;
-        s.bytearray_obj.typecode = BYTEARRAY_TYPECODE;
-        s.bytearray_obj.len = CIRCUITPY_JSON_READ_CHUNK_SIZE;
-        s.bytearray_obj.free = 0;
-        s.bytearray_obj.items = character_buffer;
-        s.python_readinto[2] = MP_OBJ_FROM_PTR(&s.bytearray_obj);
-        s.stream_obj = &s;
-        s.read = json_python_readinto;
-    } else {
-        stream_p = mp_get_stream_raise(stream_obj, MP_STREAM_OP_READ);
-        s.stream_obj = stream_obj;
-        s.read = stream_p->read;
-        s.errcode = 0;
-        s.cur = 0;
+static void json_stream_unread(json_stream_t *s) {
+    mp_off_t unread = s->end - s->ptr;
+    if (s->read != NULL && s->python_readinto[0] == MP_OBJ_NULL && unread > 0) {
+        int errcode;
+        mp_stream_seek(s->stream_obj, -unread, MP_SEEK_CUR, &errcode);
+        s->ptr = s->end;
     }
+}
 
+static MP_NORETURN void json_syntax_error(json_stream_t *s) {
+    json_stream_unread(s);
+    mp_raise_ValueError(MP_ERROR_TEXT("syntax error in JSON"));
+}
+
+// CIRCUITPY-CHANGE: parse one value, starting at the current character and
+// leaving the character just after the value as the current one.
+static mp_obj_t json_parse_value(json_stream_t *s_in) {
+    json_stream_t s = *s_in;
     JSON_DEBUG("got JSON stream\n");
     vstr_t vstr;
     vstr_init(&vstr, 8);
@@ -223,7 +245,6 @@ static mp_obj_t _mod_json_load(mp_obj_t stream_obj, bool return_first_json) {
     mp_obj_t stack_top = MP_OBJ_NULL;
     const mp_obj_type_t *stack_top_type = NULL;
     mp_obj_t stack_key = MP_OBJ_NULL;
-    S_NEXT(s);
     for (;;) {
     cont:
         if (S_END(s)) {
@@ -405,54 +426,275 @@ static mp_obj_t _mod_json_load(mp_obj_t stream_obj, bool return_first_json) {
         }
     }
 success:
+    if (stack_top == MP_OBJ_NULL || stack.len != 0) {
+        // not exactly 1 object
+        goto fail;
+    }
+    vstr_clear(&vstr);
     // CIRCUITPY-CHANGE
+    *s_in = s;
+    return stack_top;
+
+fail:
+    json_syntax_error(&s);
+}
+
+// CIRCUITPY-CHANGE
+static mp_obj_t _mod_json_load(json_stream_t *s, bool return_first_json) {
+    S_NEXT(*s);
+    mp_obj_t obj = json_parse_value(s);
 
     // It is legal for a stream to have contents after JSON.
     // E.g., A UART is not closed after receiving an object; in load() we will
     //   return the first complete JSON object, while in loads() we will retain
     //   strict adherence to the buffer's complete semantic.
     if (!return_first_json) {
-        while (unichar_isspace(S_CUR(s))) {
-            S_NEXT(s);
+        while (unichar_isspace(S_CUR(*s))) {
+            S_NEXT(*s);
         }
-        if (!S_END(s)) {
+        if (!S_END(*s)) {
             // unexpected chars
-            goto fail;
+            json_syntax_error(s);
         }
     }
-    if (stack_top == MP_OBJ_NULL || stack.len != 0) {
-        // not exactly 1 object
-        goto fail;
-    }
-    vstr_clear(&vstr);
-    return stack_top;
-
-fail:
-    mp_raise_ValueError(MP_ERROR_TEXT("syntax error in JSON"));
+    json_stream_unread(s);
+    return obj;
 }
 
 // CIRCUITPY-CHANGE
+static void json_stream_init(json_stream_t *s, mp_obj_t stream_obj, byte *buf) {
+    const mp_stream_p_t *stream_p = mp_proto_get(0, stream_obj);
+    s->python_readinto[0] = MP_OBJ_NULL;
+    s->buf = buf;
+    s->buf_size = CIRCUITPY_JSON_READ_CHUNK_SIZE;
+    if (stream_p == NULL) {
+        mp_load_method(stream_obj, MP_QSTR_readinto, s->python_readinto);
+        s->bytearray_obj.base.type = &mp_type_bytearray;
+        s->bytearray_obj.typecode = BYTEARRAY_TYPECODE;
+        s->bytearray_obj.len = CIRCUITPY_JSON_READ_CHUNK_SIZE;
+        s->bytearray_obj.free = 0;
+        s->bytearray_obj.items = buf;
+        s->python_readinto[2] = MP_OBJ_FROM_PTR(&s->bytearray_obj);
+        s->stream_obj = s;
+        s->read = json_python_readinto;
+    } else {
+        stream_p = mp_get_stream_raise(stream_obj, MP_STREAM_OP_READ);
+        s->stream_obj = stream_obj;
+        s->read = stream_p->read;
+        if (!json_stream_can_seek(stream_obj, stream_p)) {
+            s->buf_size = 1;
+        }
+    }
+    s->ptr = s->end = s->buf;
+}
+
 static mp_obj_t mod_json_load(mp_obj_t stream_obj) {
-    return _mod_json_load(stream_obj, true);
+    json_stream_t s;
+    uint8_t character_buffer[CIRCUITPY_JSON_READ_CHUNK_SIZE];
+    json_stream_init(&s, stream_obj, character_buffer);
+    return _mod_json_load(&s, true);
 }
 static MP_DEFINE_CONST_FUN_OBJ_1(mod_json_load_obj, mod_json_load);
 
 static mp_obj_t mod_json_loads(mp_obj_t obj) {
     mp_buffer_info_t bufinfo;
     mp_get_buffer_raise(obj, &bufinfo, MP_BUFFER_READ);
-    vstr_t vstr = {bufinfo.len, bufinfo.len, (char *)bufinfo.buf, true};
-    mp_obj_stringio_t sio = {{&mp_type_stringio}, &vstr, 0, MP_OBJ_NULL};
-    // CIRCUITPY-CHANGE
-    return _mod_json_load(MP_OBJ_FROM_PTR(&sio), false);
+    // CIRCUITPY-CHANGE: scan the buffer directly rather than through a stream
+    json_stream_t s;
+    s.read = NULL;
+    s.python_readinto[0] = MP_OBJ_NULL;
+    s.ptr = bufinfo.buf;
+    s.end = s.ptr + bufinfo.len;
+    return _mod_json_load(&s, false);
 }
 static MP_DEFINE_CONST_FUN_OBJ_1(mod_json_loads_obj, mod_json_loads);
 
+// CIRCUITPY-CHANGE
+#if MICROPY_PY_JSON_ITERLOAD
+
+// iterload() yields the items of one array or object in the document at a
+// time, so only one item needs to be in memory at once.  Everything outside
+// the selected container is scanned over without being built.
+
+typedef struct _mp_obj_json_iterload_t {
+    mp_obj_base_t base;
+    json_stream_t s;
+    // The closing bracket of the container being iterated, or 0 when done.
+    byte close;
+    byte buf[CIRCUITPY_JSON_READ_CHUNK_SIZE];
+} mp_obj_json_iterload_t;
+
+static bool json_is_space(byte c) {
+    // Like the parser, treat commas and colons as whitespace.
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == ',' || c == ':';
+}
+
+static void json_skip_space(json_stream_t *s) {
+    while (json_is_space(S_CUR(*s))) {
+        S_NEXT(*s);
+    }
+}
+
+static void json_skip_value(json_stream_t *s) {
+    size_t depth = 0;
+    for (;;) {
+        byte c = S_CUR(*s);
+        if (S_END(*s)) {
+            json_syntax_error(s);
+        }
+        if (json_is_space(c)) {
+            S_NEXT(*s);
+            continue;
+        } else if (c == '[' || c == '{') {
+            depth++;
+            S_NEXT(*s);
+            continue;
+        } else if (c == ']' || c == '}') {
+            if (depth == 0) {
+                json_syntax_error(s);
+            }
+            depth--;
+            S_NEXT(*s);
+        } else if (c == '"') {
+            while (S_NEXT(*s) != '"') {
+                if (S_END(*s)) {
+                    json_syntax_error(s);
+                }
+                if (S_CUR(*s) == '\\') {
+                    S_NEXT(*s);
+                }
+            }
+            S_NEXT(*s);
+        } else {
+            // A number or literal; it is not checked when skipped.
+            do {
+                c = S_NEXT(*s);
+            } while (c != S_EOF && !json_is_space(c) && c != ']' && c != '}');
+        }
+        if (depth == 0) {
+            return;
+        }
+    }
+}
+
+static mp_obj_t json_iterload_iternext(mp_obj_t self_in) {
+    mp_obj_json_iterload_t *self = MP_OBJ_TO_PTR(self_in);
+    json_stream_t *s = &self->s;
+    if (self->close == 0) {
+        return MP_OBJ_STOP_ITERATION;
+    }
+    json_skip_space(s);
+    if (S_CUR(*s) == self->close) {
+        S_NEXT(*s);
+        self->close = 0;
+        json_stream_unread(s);
+        return MP_OBJ_STOP_ITERATION;
+    }
+    if (S_END(*s)) {
+        json_syntax_error(s);
+    }
+    mp_obj_t value = json_parse_value(s);
+    if (self->close == ']') {
+        return value;
+    }
+    if (!mp_obj_is_str(value)) {
+        json_syntax_error(s);
+    }
+    mp_obj_t items[2] = { value, MP_OBJ_NULL };
+    json_skip_space(s);
+    if (S_END(*s)) {
+        json_syntax_error(s);
+    }
+    items[1] = json_parse_value(s);
+    return mp_obj_new_tuple(2, items);
+}
+
+static MP_DEFINE_CONST_OBJ_TYPE(
+    mp_type_json_iterload,
+    MP_QSTR_iterload,
+    MP_TYPE_FLAG_ITER_IS_ITERNEXT,
+    iter, json_iterload_iternext
+    );
+
+static mp_obj_t mod_json_iterload(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_stream, ARG_path };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_stream, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_path, MP_ARG_OBJ, {.u_rom_obj = MP_ROM_PTR(&mp_const_empty_tuple_obj)} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    size_t path_len;
+    mp_obj_t *path;
+    mp_obj_get_array(args[ARG_path].u_obj, &path_len, &path);
+
+    mp_obj_json_iterload_t *self = mp_obj_malloc(mp_obj_json_iterload_t, &mp_type_json_iterload);
+    self->close = 0;
+    json_stream_t *s = &self->s;
+    json_stream_init(s, args[ARG_stream].u_obj, self->buf);
+    S_NEXT(*s);
+
+    // Walk down to the selected container.  Strings select a member of an
+    // object and integers an element of an array.
+    for (size_t i = 0; i < path_len; i++) {
+        json_skip_space(s);
+        bool index = mp_obj_is_small_int(path[i]);
+        if (S_CUR(*s) != (index ? '[' : '{')) {
+            mp_raise_type_arg(&mp_type_KeyError, path[i]);
+        }
+        S_NEXT(*s);
+        mp_int_t skip = index ? MP_OBJ_SMALL_INT_VALUE(path[i]) : 0;
+        for (;;) {
+            json_skip_space(s);
+            if (S_END(*s)) {
+                json_syntax_error(s);
+            }
+            if (S_CUR(*s) == ']' || S_CUR(*s) == '}' || skip < 0) {
+                mp_raise_type_arg(&mp_type_KeyError, path[i]);
+            }
+            if (index) {
+                if (skip-- == 0) {
+                    break;
+                }
+            } else {
+                mp_obj_t key = json_parse_value(s);
+                json_skip_space(s);
+                if (mp_obj_equal(key, path[i])) {
+                    break;
+                }
+            }
+            json_skip_value(s);
+        }
+    }
+
+    json_skip_space(s);
+    if (S_CUR(*s) == '[') {
+        self->close = ']';
+    } else if (S_CUR(*s) == '{') {
+        self->close = '}';
+    } else if (S_END(*s)) {
+        json_syntax_error(s);
+    } else {
+        mp_raise_TypeError(MP_ERROR_TEXT("object not iterable"));
+    }
+    S_NEXT(*s);
+    return MP_OBJ_FROM_PTR(self);
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(mod_json_iterload_obj, 1, mod_json_iterload);
+
+#endif
+
 static const mp_rom_map_elem_t mp_module_json_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_json) },
     { MP_ROM_QSTR(MP_QSTR_dump), MP_ROM_PTR(&mod_json_dump_obj) },
     { MP_ROM_QSTR(MP_QSTR_dumps), MP_ROM_PTR(&mod_json_dumps_obj) },
     { MP_ROM_QSTR(MP_QSTR_load), MP_ROM_PTR(&mod_json_load_obj) },
     { MP_ROM_QSTR(MP_QSTR_loads), MP_ROM_PTR(&mod_json_loads_obj) },
+    // CIRCUITPY-CHANGE
+    #if MICROPY_PY_JSON_ITERLOAD
+    { MP_ROM_QSTR(MP_QSTR_iterload), MP_ROM_PTR(&mod_json_iterload_obj) },
+    #endif
 };
 
 static MP_DEFINE_CONST_DICT(mp_module_json_globals, mp_module_json_globals_table);
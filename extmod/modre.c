@@ -44,9 +44,15 @@
 #include "lib/re1.5/re1.5.h"
 
 #define FLAG_DEBUG 0x1000
+// CIRCUITPY-CHANGE
+#define FLAG_PIKEVM 0x2000
 
 typedef struct _mp_obj_re_t {
     mp_obj_base_t base;
+    // CIRCUITPY-CHANGE
+    #if MICROPY_PY_RE_PIKEVM
+    bool pikevm;
+    #endif
     ByteProg re;
 } mp_obj_re_t;
 
@@ -188,6 +194,59 @@ static MP_DEFINE_CONST_OBJ_TYPE(
     );
 #endif
 
+// CIRCUITPY-CHANGE
+static int re_exec_prog(mp_obj_re_t *self, Subject *subj, const char **caps, int caps_num, bool is_anchored) {
+    #if MICROPY_PY_RE_PIKEVM
+    if (self->pikevm) {
+        return re1_5_pikevm(&self->re, subj, caps, caps_num, is_anchored);
+    }
+    #endif
+    return re1_5_recursiveloopprog(&self->re, subj, caps, caps_num, is_anchored);
+}
+
+#if MICROPY_PY_RE_CACHE_SIZE > 0
+
+// Patterns passed as strings to the module-level functions are compiled on
+// every call, so keep the most recently used ones.  Entries are (pattern,
+// compiled) pairs, most recently used first.
+MP_REGISTER_ROOT_POINTER(mp_obj_t re_cache[2 * MICROPY_PY_RE_CACHE_SIZE]);
+
+static mp_obj_re_t *re_compile_cached(mp_obj_t pattern) {
+    mp_obj_t *cache = MP_STATE_VM(re_cache);
+    mp_obj_t compiled = MP_OBJ_NULL;
+    size_t i = 0;
+    for (; i < MICROPY_PY_RE_CACHE_SIZE; i++) {
+        mp_obj_t key = cache[2 * i];
+        if (key == MP_OBJ_NULL) {
+            break;
+        }
+        // Check the type first so str and bytes patterns aren't compared.
+        if (mp_obj_get_type(key) == mp_obj_get_type(pattern) && mp_obj_equal(key, pattern)) {
+            compiled = cache[2 * i + 1];
+            break;
+        }
+    }
+    if (i == MICROPY_PY_RE_CACHE_SIZE) {
+        i--;
+    }
+    if (compiled == MP_OBJ_NULL) {
+        compiled = mod_re_compile(1, &pattern);
+    }
+    // Move the entry to the front, dropping the least recently used if full.
+    memmove(&cache[2], &cache[0], 2 * i * sizeof(mp_obj_t));
+    cache[0] = pattern;
+    cache[1] = compiled;
+    return MP_OBJ_TO_PTR(compiled);
+}
+
+#else
+
+static mp_obj_re_t *re_compile_cached(mp_obj_t pattern) {
+    return MP_OBJ_TO_PTR(mod_re_compile(1, &pattern));
+}
+
+#endif
+
 static void re_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
     (void)kind;
     mp_obj_re_t *self = MP_OBJ_TO_PTR(self_in);
@@ -202,7 +261,8 @@ static mp_obj_t re_exec_helper(bool is_anchored, uint n_args, const mp_obj_t *ar
         self = MP_OBJ_TO_PTR(args[0]);
         was_compiled = true;
     } else {
-        self = MP_OBJ_TO_PTR(mod_re_compile(1, args));
+        // CIRCUITPY-CHANGE
+        self = re_compile_cached(args[0]);
     }
     Subject subj;
     size_t len;
@@ -234,7 +294,8 @@ static mp_obj_t re_exec_helper(bool is_anchored, uint n_args, const mp_obj_t *ar
     mp_obj_match_t *match = m_new_obj_var(mp_obj_match_t, caps, char *, caps_num);
     // cast is a workaround for a bug in msvc: it treats const char** as a const pointer instead of a pointer to pointer to const char
     memset((char *)match->caps, 0, caps_num * sizeof(char *));
-    int res = re1_5_recursiveloopprog(&self->re, &subj, match->caps, caps_num, is_anchored);
+    // CIRCUITPY-CHANGE
+    int res = re_exec_prog(self, &subj, match->caps, caps_num, is_anchored);
     if (res == 0) {
         m_del_var(mp_obj_match_t, caps, char *, caps_num, match);
         return mp_const_none;
@@ -275,7 +336,8 @@ static mp_obj_t re_split(size_t n_args, const mp_obj_t *args) {
     while (true) {
         // cast is a workaround for a bug in msvc: it treats const char** as a const pointer instead of a pointer to pointer to const char
         memset((char **)caps, 0, caps_num * sizeof(char *));
-        int res = re1_5_recursiveloopprog(&self->re, &subj, caps, caps_num, false);
+        // CIRCUITPY-CHANGE
+        int res = re_exec_prog(self, &subj, caps, caps_num, false);
 
         // if we didn't have a match, or had an empty match, it's time to stop
         if (!res || caps[0] == caps[1]) {
@@ -308,7 +370,8 @@ static mp_obj_t re_sub_helper(size_t n_args, const mp_obj_t *args) {
     if (mp_obj_is_type(args[0], (mp_obj_type_t *)&re_type)) {
         self = MP_OBJ_TO_PTR(args[0]);
     } else {
-        self = MP_OBJ_TO_PTR(mod_re_compile(1, args));
+        // CIRCUITPY-CHANGE
+        self = re_compile_cached(args[0]);
     }
     mp_obj_t replace = args[1];
     mp_obj_t where = args[2];
@@ -335,7 +398,8 @@ static mp_obj_t re_sub_helper(size_t n_args, const mp_obj_t *args) {
     for (;;) {
         // cast is a workaround for a bug in msvc: it treats const char** as a const pointer instead of a pointer to pointer to const char
         memset((char *)match->caps, 0, caps_num * sizeof(char *));
-        int res = re1_5_recursiveloopprog(&self->re, &subj, match->caps, caps_num, false);
+        // CIRCUITPY-CHANGE
+        int res = re_exec_prog(self, &subj, match->caps, caps_num, false);
 
         // If we didn't have a match, or had an empty match, it's time to stop
         if (!res || match->caps[0] == match->caps[1]) {
@@ -445,6 +509,56 @@ static MP_DEFINE_CONST_OBJ_TYPE(
     );
 #endif
 
+// CIRCUITPY-CHANGE
+#if MICROPY_PY_RE_PIKEVM
+
+// Size in bytes of the instruction at pc.
+static int re_inst_len(const char *pc) {
+    switch (*pc) {
+        case Class:
+        case ClassNot:
+            return 2 + *(unsigned char *)(pc + 1) * 2;
+        case Any:
+        case Bol:
+        case Eol:
+        case Match:
+            return 1;
+        default:
+            return 2;
+    }
+}
+
+// Whether backtracking may take exponential time on the program: true if it
+// has a loop whose body holds another choice (a nested repeat, an optional
+// part or an alternation), as in (a+)+ or (a|ab)*.
+static bool re_prone_to_backtrack(ByteProg *prog) {
+    const char *start = prog->insts + NON_ANCHORED_PREFIX;
+    const char *end = prog->insts + prog->bytelen;
+    for (const char *pc = start; pc < end; pc += re_inst_len(pc)) {
+        if (*pc != Jmp && *pc != Split && *pc != RSplit) {
+            continue;
+        }
+        int off = (signed char)pc[1];
+        if (off >= 0) {
+            continue;
+        }
+        // A backward jump closes a loop.  For x* the loop starts with its
+        // own split, which isn't counted.
+        const char *body = pc + 2 + off;
+        if (*pc == Jmp) {
+            body += 2;
+        }
+        for (const char *p = body; p < pc; p += re_inst_len(p)) {
+            if (*p == Split || *p == RSplit) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+#endif
+
 static mp_obj_t mod_re_compile(size_t n_args, const mp_obj_t *args) {
     (void)n_args;
     const char *re_str = mp_obj_str_get_str(args[0]);
@@ -456,7 +570,8 @@ static mp_obj_t mod_re_compile(size_t n_args, const mp_obj_t *args) {
         goto error;
     }
     mp_obj_re_t *o = mp_obj_malloc_var(mp_obj_re_t, re.insts, char, size, (mp_obj_type_t *)&re_type);
-    #if MICROPY_PY_RE_DEBUG
+    // CIRCUITPY-CHANGE
+    #if MICROPY_PY_RE_DEBUG || MICROPY_PY_RE_PIKEVM
     int flags = 0;
     if (n_args > 1) {
         flags = mp_obj_get_int(args[1]);
@@ -468,6 +583,10 @@ static mp_obj_t mod_re_compile(size_t n_args, const mp_obj_t *args) {
         // CIRCUITPY-CHANGE: capitalized
         mp_raise_ValueError(MP_ERROR_TEXT("Error in regex"));
     }
+    // CIRCUITPY-CHANGE
+    #if MICROPY_PY_RE_PIKEVM
+    o->pikevm = (flags & FLAG_PIKEVM) || re_prone_to_backtrack(&o->re);
+    #endif
     #if MICROPY_PY_RE_DEBUG
     if (flags & FLAG_DEBUG) {
         re1_5_dumpcode(&o->re);
@@ -489,6 +608,10 @@ static const mp_rom_map_elem_t mp_module_re_globals_table[] = {
     #if MICROPY_PY_RE_DEBUG
     { MP_ROM_QSTR(MP_QSTR_DEBUG), MP_ROM_INT(FLAG_DEBUG) },
     #endif
+    // CIRCUITPY-CHANGE
+    #if MICROPY_PY_RE_PIKEVM
+    { MP_ROM_QSTR(MP_QSTR_PIKEVM), MP_ROM_INT(FLAG_PIKEVM) },
+    #endif
 };
 
 static MP_DEFINE_CONST_DICT(mp_module_re_globals, mp_module_re_globals_table);
@@ -508,6 +631,12 @@ MP_REGISTER_EXTENSIBLE_MODULE(MP_QSTR_re, mp_module_re);
 
 #include "lib/re1.5/compilecode.c"
 #include "lib/re1.5/recursiveloop.c"
+// CIRCUITPY-CHANGE
+#if MICROPY_PY_RE_PIKEVM
+#define re1_5_alloc(n) m_new(char, n)
+#define re1_5_free(p, n) m_del(char, p, n)
+#include "lib/re1.5/pike.c"
+#endif
 #include "lib/re1.5/charclass.c"
 
 #if MICROPY_PY_RE_DEBUG
@@ -68,6 +68,11 @@
 typedef struct _poll_obj_t {
     mp_obj_t obj;
     mp_uint_t (*ioctl)(mp_obj_t obj, mp_uint_t request, uintptr_t arg, int *errcode);
+    // CIRCUITPY-CHANGE: next object in poll_set_t::active
+    struct _poll_obj_t *next;
+    bool active;
+    // Events the object notifies about, from mp_stream_p_t::poll_notify.
+    uint8_t notify;
     #if MICROPY_PY_SELECT_POSIX_OPTIMISATIONS
     // If the pollable object has an associated file descriptor, then pollfd points to an entry
     // in poll_set_t::pollfds, and the events/revents fields for this object are stored in the
@@ -89,6 +94,15 @@ typedef struct _poll_set_t {
     // Map containing a dict with key=object to poll, value=its corresponding poll_obj_t.
     mp_map_t map;
 
+    // CIRCUITPY-CHANGE: objects that need their ioctl called on the next poll, in
+    // the order they were added.  This is every object except the ones that found
+    // nothing to report last time and will notify when that changes.
+    poll_obj_t *active;
+    poll_obj_t **active_tail;
+    #if MICROPY_PY_SELECT_POLL_NOTIFY
+    mp_uint_t notify_seq;
+    #endif
+
     #if MICROPY_PY_SELECT_POSIX_OPTIMISATIONS
     // Array of pollfd entries for objects that have a file descriptor.
     unsigned short alloc; // memory allocated for pollfds
@@ -100,6 +114,12 @@ typedef struct _poll_set_t {
 
 static void poll_set_init(poll_set_t *poll_set, size_t n) {
     mp_map_init(&poll_set->map, n);
+    // CIRCUITPY-CHANGE
+    poll_set->active = NULL;
+    poll_set->active_tail = &poll_set->active;
+    #if MICROPY_PY_SELECT_POLL_NOTIFY
+    poll_set->notify_seq = mp_stream_poll_notify_seq();
+    #endif
     #if MICROPY_PY_SELECT_POSIX_OPTIMISATIONS
     poll_set->alloc = 0;
     poll_set->max_used = 0;
@@ -230,6 +250,69 @@ static inline void poll_obj_set_revents(poll_obj_t *poll_obj, mp_uint_t revents)
 
 #endif
 
+// CIRCUITPY-CHANGE: maintenance of poll_set_t::active
+static void poll_set_activate(poll_set_t *poll_set, poll_obj_t *poll_obj) {
+    if (!poll_obj->active) {
+        poll_obj->active = true;
+        poll_obj->next = NULL;
+        *poll_set->active_tail = poll_obj;
+        poll_set->active_tail = &poll_obj->next;
+    }
+}
+
+// Unlink an active object, given the link that points to it.
+static void poll_set_unlink(poll_set_t *poll_set, poll_obj_t **link) {
+    poll_obj_t *poll_obj = *link;
+    *link = poll_obj->next;
+    if (poll_set->active_tail == &poll_obj->next) {
+        poll_set->active_tail = link;
+    }
+    poll_obj->active = false;
+}
+
+static void poll_set_deactivate(poll_set_t *poll_set, poll_obj_t *poll_obj) {
+    if (poll_obj->active) {
+        poll_obj_t **link = &poll_set->active;
+        while (*link != poll_obj) {
+            link = &(*link)->next;
+        }
+        poll_set_unlink(poll_set, link);
+    }
+}
+
+// Whether an object that found nothing to report can wait for a notification
+// instead of being polled again.
+static inline bool poll_obj_can_wait(poll_obj_t *poll_obj) {
+    return poll_obj->notify != 0
+           && (poll_obj_get_events(poll_obj) & (MP_STREAM_POLL_RD | MP_STREAM_POLL_WR) & ~poll_obj->notify) == 0;
+}
+
+#if MICROPY_PY_SELECT_POLL_NOTIFY
+// Put every registered object that was notified since the last poll back on
+// the active list.
+static void poll_set_take_notifications(poll_set_t *poll_set) {
+    for (;;) {
+        mp_obj_t obj = mp_stream_poll_next_notified(&poll_set->notify_seq);
+        if (obj == MP_OBJ_NULL) {
+            return;
+        }
+        if (obj == MP_OBJ_SENTINEL) {
+            // Some notifications were lost, so any object may be ready.
+            for (mp_uint_t i = 0; i < poll_set->map.alloc; ++i) {
+                if (mp_map_slot_is_filled(&poll_set->map, i) && poll_set->map.table[i].value != MP_OBJ_NULL) {
+                    poll_set_activate(poll_set, MP_OBJ_TO_PTR(poll_set->map.table[i].value));
+                }
+            }
+            continue;
+        }
+        mp_map_elem_t *elem = mp_map_lookup(&poll_set->map, mp_obj_id(obj), MP_MAP_LOOKUP);
+        if (elem != NULL && elem->value != MP_OBJ_NULL) {
+            poll_set_activate(poll_set, MP_OBJ_TO_PTR(elem->value));
+        }
+    }
+}
+#endif
+
 static void poll_set_add_obj(poll_set_t *poll_set, const mp_obj_t *obj, mp_uint_t obj_len, mp_uint_t events, bool or_events) {
     for (mp_uint_t i = 0; i < obj_len; i++) {
         mp_map_elem_t *elem = mp_map_lookup(&poll_set->map, mp_obj_id(obj[i]), MP_MAP_LOOKUP_ADD_IF_NOT_FOUND);
@@ -241,6 +324,9 @@ static void poll_set_add_obj(poll_set_t *poll_set, const mp_obj_t *obj, mp_uint_
 
             poll_obj_t *poll_obj = m_new_obj(poll_obj_t);
             poll_obj->obj = obj[i];
+            // CIRCUITPY-CHANGE
+            poll_obj->active = false;
+            poll_obj->notify = 0;
 
             #if MICROPY_PY_SELECT_POSIX_OPTIMISATIONS
             int fd = -1;
@@ -255,6 +341,9 @@ static void poll_set_add_obj(poll_set_t *poll_set, const mp_obj_t *obj, mp_uint_
                 // An object passed in.  Check if it has a file descriptor.
                 const mp_stream_p_t *stream_p = mp_get_stream_raise(obj[i], MP_STREAM_OP_IOCTL);
                 poll_obj->ioctl = stream_p->ioctl;
+                #if MICROPY_PY_SELECT_POLL_NOTIFY
+                poll_obj->notify = stream_p->poll_notify;
+                #endif
                 int err;
                 mp_uint_t res = stream_p->ioctl(obj[i], MP_STREAM_GET_FILENO, 0, &err);
                 if (res != MP_STREAM_ERROR) {
@@ -271,11 +360,16 @@ static void poll_set_add_obj(poll_set_t *poll_set, const mp_obj_t *obj, mp_uint_
             #else
             const mp_stream_p_t *stream_p = mp_get_stream_raise(obj[i], MP_STREAM_OP_IOCTL);
             poll_obj->ioctl = stream_p->ioctl;
+            #if MICROPY_PY_SELECT_POLL_NOTIFY
+            poll_obj->notify = stream_p->poll_notify;
+            #endif
             #endif
 
             poll_obj_set_events(poll_obj, events);
             poll_obj_set_revents(poll_obj, 0);
             elem->value = MP_OBJ_FROM_PTR(poll_obj);
+            // CIRCUITPY-CHANGE
+            poll_set_activate(poll_set, poll_obj);
         } else {
             // object exists; update its events
             poll_obj_t *poll_obj = (poll_obj_t *)MP_OBJ_TO_PTR(elem->value);
@@ -287,23 +381,27 @@ static void poll_set_add_obj(poll_set_t *poll_set, const mp_obj_t *obj, mp_uint_
             (void)or_events;
             #endif
             poll_obj_set_events(poll_obj, events);
+            // CIRCUITPY-CHANGE
+            poll_set_activate(poll_set, poll_obj);
         }
     }
 }
 
-// For each object in the poll set, poll it once.
+// CIRCUITPY-CHANGE: For each active object in the poll set, poll it once.
 static mp_uint_t poll_set_poll_once(poll_set_t *poll_set, size_t *rwx_num) {
-    mp_uint_t n_ready = 0;
-    for (mp_uint_t i = 0; i < poll_set->map.alloc; ++i) {
-        if (!mp_map_slot_is_filled(&poll_set->map, i)) {
-            continue;
-        }
+    #if MICROPY_PY_SELECT_POLL_NOTIFY
+    poll_set_take_notifications(poll_set);
+    #endif
 
-        poll_obj_t *poll_obj = MP_OBJ_TO_PTR(poll_set->map.table[i].value);
+    mp_uint_t n_ready = 0;
+    poll_obj_t **link = &poll_set->active;
+    while (*link != NULL) {
+        poll_obj_t *poll_obj = *link;
 
         #if MICROPY_PY_SELECT_POSIX_OPTIMISATIONS
         if (poll_obj->pollfd != NULL) {
             // Object has file descriptor so will be polled separately by poll().
+            link = &poll_obj->next;
             continue;
         }
         #endif
@@ -317,6 +415,13 @@ static mp_uint_t poll_set_poll_once(poll_set_t *poll_set, size_t *rwx_num) {
             mp_raise_OSError(errcode);
         }
 
+        // CIRCUITPY-CHANGE: wait for a notification rather than polling again
+        if (ret == 0 && poll_obj_can_wait(poll_obj)) {
+            poll_set_unlink(poll_set, link);
+            continue;
+        }
+        link = &poll_obj->next;
+
         if (ret != 0) {
             // object is ready
             n_ready += 1;
@@ -489,7 +594,8 @@ typedef struct _mp_obj_poll_t {
     mp_obj_base_t base;
     poll_set_t poll_set;
     short iter_cnt;
-    short iter_idx;
+    // CIRCUITPY-CHANGE: where ipoll's iterator continues in poll_set.active
+    poll_obj_t *iter_next;
     int flags;
     // callee-owned tuple
     mp_obj_t ret_tuple;
@@ -514,18 +620,21 @@ static mp_obj_t poll_unregister(mp_obj_t self_in, mp_obj_t obj_in) {
     mp_obj_poll_t *self = MP_OBJ_TO_PTR(self_in);
     mp_map_elem_t *elem = mp_map_lookup(&self->poll_set.map, mp_obj_id(obj_in), MP_MAP_LOOKUP_REMOVE_IF_FOUND);
 
-    #if MICROPY_PY_SELECT_POSIX_OPTIMISATIONS
-    if (elem != NULL) {
+    // CIRCUITPY-CHANGE: take the object off the active list, without losing ipoll's place
+    if (elem != NULL && elem->value != MP_OBJ_NULL) {
         poll_obj_t *poll_obj = (poll_obj_t *)MP_OBJ_TO_PTR(elem->value);
+        if (self->iter_next == poll_obj) {
+            self->iter_next = poll_obj->next;
+        }
+        poll_set_deactivate(&self->poll_set, poll_obj);
+        #if MICROPY_PY_SELECT_POSIX_OPTIMISATIONS
         if (poll_obj->pollfd != NULL) {
             poll_obj->pollfd->fd = -1;
             --self->poll_set.used;
         }
         elem->value = MP_OBJ_NULL;
+        #endif
     }
-    #else
-    (void)elem;
-    #endif
 
     // TODO raise KeyError if obj didn't exist in map
     return mp_const_none;
@@ -539,7 +648,10 @@ static mp_obj_t poll_modify(mp_obj_t self_in, mp_obj_t obj_in, mp_obj_t eventmas
     if (elem == NULL) {
         mp_raise_OSError(MP_ENOENT);
     }
-    poll_obj_set_events((poll_obj_t *)MP_OBJ_TO_PTR(elem->value), mp_obj_get_int(eventmask_in));
+    poll_obj_t *poll_obj = (poll_obj_t *)MP_OBJ_TO_PTR(elem->value);
+    poll_obj_set_events(poll_obj, mp_obj_get_int(eventmask_in));
+    // CIRCUITPY-CHANGE: check the new events on the next poll
+    poll_set_activate(&self->poll_set, poll_obj);
     return mp_const_none;
 }
 MP_DEFINE_CONST_FUN_OBJ_3(poll_modify_obj, poll_modify);
@@ -574,11 +686,8 @@ static mp_obj_t poll_poll(size_t n_args, const mp_obj_t *args) {
     // one or more objects are ready, or we had a timeout
     mp_obj_list_t *ret_list = MP_OBJ_TO_PTR(mp_obj_new_list(n_ready, NULL));
     n_ready = 0;
-    for (mp_uint_t i = 0; i < self->poll_set.map.alloc; ++i) {
-        if (!mp_map_slot_is_filled(&self->poll_set.map, i)) {
-            continue;
-        }
-        poll_obj_t *poll_obj = MP_OBJ_TO_PTR(self->poll_set.map.table[i].value);
+    // CIRCUITPY-CHANGE: only active objects can be ready
+    for (poll_obj_t *poll_obj = self->poll_set.active; poll_obj != NULL; poll_obj = poll_obj->next) {
         if (poll_obj_get_revents(poll_obj) != 0) {
             mp_obj_t tuple[2] = {poll_obj->obj, MP_OBJ_NEW_SMALL_INT(poll_obj_get_revents(poll_obj))};
             ret_list->items[n_ready++] = mp_obj_new_tuple(2, tuple);
@@ -597,7 +706,8 @@ static mp_obj_t poll_ipoll(size_t n_args, const mp_obj_t *args) {
 
     int n_ready = poll_poll_internal(n_args, args);
     self->iter_cnt = n_ready;
-    self->iter_idx = 0;
+    // CIRCUITPY-CHANGE
+    self->iter_next = self->poll_set.active;
 
     return args[0];
 }
@@ -612,12 +722,9 @@ static mp_obj_t poll_iternext(mp_obj_t self_in) {
 
     self->iter_cnt--;
 
-    for (mp_uint_t i = self->iter_idx; i < self->poll_set.map.alloc; ++i) {
-        self->iter_idx++;
-        if (!mp_map_slot_is_filled(&self->poll_set.map, i)) {
-            continue;
-        }
-        poll_obj_t *poll_obj = MP_OBJ_TO_PTR(self->poll_set.map.table[i].value);
+    // CIRCUITPY-CHANGE: only active objects can be ready
+    for (poll_obj_t *poll_obj = self->iter_next; poll_obj != NULL; poll_obj = poll_obj->next) {
+        self->iter_next = poll_obj->next;
         if (poll_obj_get_revents(poll_obj) != 0) {
             mp_obj_tuple_t *t = MP_OBJ_TO_PTR(self->ret_tuple);
             t->items[0] = poll_obj->obj;
@@ -657,6 +764,8 @@ static mp_obj_t select_poll(void) {
     mp_obj_poll_t *poll = mp_obj_malloc(mp_obj_poll_t, &mp_type_poll);
     poll_set_init(&poll->poll_set, 0);
     poll->iter_cnt = 0;
+    // CIRCUITPY-CHANGE
+    poll->iter_next = NULL;
     poll->ret_tuple = MP_OBJ_NULL;
     return MP_OBJ_FROM_PTR(poll);
 }
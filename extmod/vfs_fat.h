@@ -38,6 +38,9 @@ typedef struct _fs_user_mount_t {
     // CIRCUITPY-CHANGE: Count the users that are manipulating the blockdev via
     // native fatfs so we can lock and unlock the blockdev.
     int8_t lock_count;
+    // CIRCUITPY-CHANGE: Counts writes to the blockdev, so that anything cached
+    // from the filesystem can tell when it may be stale.
+    uint32_t write_count;
 } fs_user_mount_t;
 
 extern const byte fresult_to_errno_table[20];
@@ -51,6 +54,13 @@ MP_DECLARE_CONST_FUN_OBJ_3(fat_vfs_open_obj);
 typedef struct _pyb_file_obj_t {
     mp_obj_base_t base;
     FIL fp;
+    // Writes to files opened for appending are gathered here. Once the file
+    // has needed a new cluster, clusters are reserved ahead of time up to
+    // append_reserved.
+    uint8_t *append_buf;
+    size_t append_len;
+    FSIZE_t append_reserved;
+    bool append_reserving;
 } pyb_file_obj_t;
 
 #endif  // MICROPY_INCLUDED_EXTMOD_VFS_FAT_H
@@ -87,6 +87,8 @@ DRESULT disk_write(
     }
 
     int ret = mp_vfs_blockdev_write(&vfs->blockdev, sector, count, buff);
+    // CIRCUITPY-CHANGE
+    vfs->write_count++;
 
     if (ret == -MP_EROFS) {
         // read-only block device
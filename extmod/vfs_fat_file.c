@@ -38,6 +38,22 @@
 #include "extmod/vfs_fat.h"
 #include "supervisor/filesystem.h"
 
+// CIRCUITPY-CHANGE
+// Bytes written to a file opened with "a" that are gathered in RAM before
+// going to the filesystem. 0 writes them straight through.
+#ifndef CIRCUITPY_FATFS_APPEND_BUFFER_SIZE
+#define CIRCUITPY_FATFS_APPEND_BUFFER_SIZE (512)
+#endif
+#if CIRCUITPY_FATFS_APPEND_BUFFER_SIZE > 0 && CIRCUITPY_FATFS_APPEND_BUFFER_SIZE < FF_MIN_SS
+#error "CIRCUITPY_FATFS_APPEND_BUFFER_SIZE must be at least a sector"
+#endif
+
+// Clusters reserved at a time as a file opened with "a" grows, so that the
+// FAT is updated once for several of them.
+#ifndef CIRCUITPY_FATFS_APPEND_RESERVE_CLUSTERS
+#define CIRCUITPY_FATFS_APPEND_RESERVE_CLUSTERS (8)
+#endif
+
 // this table converts from FRESULT to POSIX errno
 const byte fresult_to_errno_table[20] = {
     [FR_OK] = 0,
@@ -79,8 +95,7 @@ static mp_uint_t file_obj_read(mp_obj_t self_in, void *buf, mp_uint_t size, int
     return sz_out;
 }
 
-static mp_uint_t file_obj_write(mp_obj_t self_in, const void *buf, mp_uint_t size, int *errcode) {
-    pyb_file_obj_t *self = MP_OBJ_TO_PTR(self_in);
+static mp_uint_t file_obj_write_through(pyb_file_obj_t *self, const void *buf, mp_uint_t size, int *errcode) {
     UINT sz_out;
     FRESULT res = f_write(&self->fp, buf, size, &sz_out);
     if (res != FR_OK) {
@@ -95,9 +110,73 @@ static mp_uint_t file_obj_write(mp_obj_t self_in, const void *buf, mp_uint_t siz
     return sz_out;
 }
 
+// CIRCUITPY-CHANGE: gather appends
+static size_t file_obj_cluster_size(pyb_file_obj_t *self) {
+    #if FF_MAX_SS != FF_MIN_SS
+    return self->fp.obj.fs->csize * self->fp.obj.fs->ssize;
+    #else
+    return self->fp.obj.fs->csize * FF_MIN_SS;
+    #endif
+}
+
+static bool file_obj_flush_append(pyb_file_obj_t *self, int *errcode) {
+    if (self->append_len == 0) {
+        return true;
+    }
+    // Reserve clusters for several more writes once these need a new one.
+    // The first new cluster is left to f_write, so that files opened for
+    // each write don't reserve clusters only to give them back on close.
+    FSIZE_t end = f_tell(&self->fp) + self->append_len;
+    if (end > self->append_reserved) {
+        size_t cluster_size = file_obj_cluster_size(self);
+        if (!self->append_reserving) {
+            self->append_reserving = true;
+            self->append_reserved = (end + cluster_size - 1) / cluster_size * cluster_size;
+        } else {
+            FSIZE_t reserve = self->append_len + cluster_size * CIRCUITPY_FATFS_APPEND_RESERVE_CLUSTERS;
+            // If this fails, the write below finds out why.
+            if (f_reserve(&self->fp, reserve) == FR_OK) {
+                self->append_reserved = f_tell(&self->fp) + reserve;
+            }
+        }
+    }
+    size_t len = self->append_len;
+    self->append_len = 0;
+    return file_obj_write_through(self, self->append_buf, len, errcode) != MP_STREAM_ERROR;
+}
+
+static mp_uint_t file_obj_write(mp_obj_t self_in, const void *buf, mp_uint_t size, int *errcode) {
+    pyb_file_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    if (self->append_buf == NULL) {
+        return file_obj_write_through(self, buf, size, errcode);
+    }
+    const uint8_t *src = buf;
+    mp_uint_t remaining = size;
+    while (remaining > 0) {
+        // Fill up to a sector boundary, so that full buffers are written as
+        // whole sectors that skip the FatFs window.
+        size_t limit = CIRCUITPY_FATFS_APPEND_BUFFER_SIZE - f_tell(&self->fp) % FF_MIN_SS;
+        size_t len = MIN(remaining, limit - self->append_len);
+        memcpy(self->append_buf + self->append_len, src, len);
+        self->append_len += len;
+        src += len;
+        remaining -= len;
+        if (self->append_len == limit && !file_obj_flush_append(self, errcode)) {
+            return MP_STREAM_ERROR;
+        }
+    }
+    return size;
+}
+
 static mp_uint_t file_obj_ioctl(mp_obj_t o_in, mp_uint_t request, uintptr_t arg, int *errcode) {
     pyb_file_obj_t *self = MP_OBJ_TO_PTR(o_in);
 
+    // CIRCUITPY-CHANGE: write out gathered appends before anything else.
+    bool flushed = self->fp.obj.fs == NULL || file_obj_flush_append(self, errcode);
+    if (!flushed && request != MP_STREAM_CLOSE) {
+        return MP_STREAM_ERROR;
+    }
+
     if (request == MP_STREAM_SEEK) {
         struct mp_stream_seek_t *s = (struct mp_stream_seek_t *)(uintptr_t)arg;
 
@@ -129,11 +208,19 @@ static mp_uint_t file_obj_ioctl(mp_obj_t o_in, mp_uint_t request, uintptr_t arg,
     } else if (request == MP_STREAM_CLOSE) {
         // if fs==NULL then the file is closed and in that case this method is a no-op
         if (self->fp.obj.fs != NULL) {
+            // CIRCUITPY-CHANGE: give back reserved clusters that weren't used.
+            if (self->append_reserving) {
+                f_reserve(&self->fp, 0);
+            }
+            self->append_buf = NULL;
             FRESULT res = f_close(&self->fp);
             if (res != FR_OK) {
                 *errcode = fresult_to_errno_table[res];
                 return MP_STREAM_ERROR;
             }
+            if (!flushed) {
+                return MP_STREAM_ERROR;
+            }
         }
         return 0;
 
@@ -285,6 +372,20 @@ static mp_obj_t fat_vfs_open(mp_obj_t self_in, mp_obj_t path_in, mp_obj_t mode_i
         f_lseek(&o->fp, f_size(&o->fp));
     }
 
+    // CIRCUITPY-CHANGE: gather writes when only appending.
+    o->append_buf = NULL;
+    o->append_len = 0;
+    o->append_reserved = 0;
+    o->append_reserving = false;
+    #if CIRCUITPY_FATFS_APPEND_BUFFER_SIZE > 0
+    if (mode == (FA_WRITE | FA_OPEN_ALWAYS)) {
+        o->append_buf = m_malloc_maybe(CIRCUITPY_FATFS_APPEND_BUFFER_SIZE);
+        // Clusters already in the chain cover the file up to here.
+        size_t cluster_size = file_obj_cluster_size(o);
+        o->append_reserved = (f_size(&o->fp) + cluster_size - 1) / cluster_size * cluster_size;
+    }
+    #endif
+
     return MP_OBJ_FROM_PTR(o);
 }
 MP_DEFINE_CONST_FUN_OBJ_3(fat_vfs_open_obj, fat_vfs_open);
@@ -4642,6 +4642,90 @@ FRESULT f_truncate (
 
 
 
+// CIRCUITPY-CHANGE
+/*-----------------------------------------------------------------------*/
+/* Reserve Clusters Past the File Pointer                                */
+/*-----------------------------------------------------------------------*/
+/* Sets the cluster chain to hold the larger of the file size and len bytes
+   past the file pointer, stretching or cutting it as needed. The file size
+   is not changed, and f_write follows the reserved clusters as the file
+   grows. Does nothing on exFAT volumes. */
+
+FRESULT f_reserve (
+    FIL* fp,        /* Pointer to the file object */
+    FSIZE_t len     /* Number of bytes to reserve past the file pointer */
+)
+{
+    FRESULT res;
+    FATFS *fs;
+    FSIZE_t end;
+    DWORD bcs, clst, ncl, n, nkeep;
+
+
+    res = validate(&fp->obj, &fs);  /* Check validity of the file object */
+    if (res != FR_OK || (res = (FRESULT)fp->err) != FR_OK) LEAVE_FF(fs, res);
+    if (!(fp->flag & FA_WRITE)) LEAVE_FF(fs, FR_DENIED);    /* Check access mode */
+#if FF_FS_EXFAT
+    if (fs->fs_type == FS_EXFAT) LEAVE_FF(fs, FR_OK);
+#endif
+
+    bcs = (DWORD)fs->csize * SS(fs);    /* Cluster size */
+    end = (len > ~(FSIZE_t)0 - fp->fptr) ? ~(FSIZE_t)0 : fp->fptr + len;
+    if (end < fp->obj.objsize) end = fp->obj.objsize;
+    nkeep = (DWORD)(end / bcs) + (end % bcs != 0 ? 1 : 0);  /* Number of clusters to keep */
+
+    if (fp->fptr > 0 && fp->clust != 0) {   /* Start at the cluster holding the byte before fptr */
+        clst = fp->clust;
+        n = (DWORD)((fp->fptr - 1) / bcs) + 1;
+    } else {                                /* Start at the top of the chain */
+        clst = fp->obj.sclust;
+        n = clst != 0 ? 1 : 0;
+    }
+    if (nkeep == 0) {       /* Empty file, remove entire cluster chain */
+        if (clst != 0) {
+            res = remove_chain(&fp->obj, clst, 0);
+            fp->obj.sclust = 0;
+            fp->flag |= FA_MODIFIED;
+        }
+    } else {
+        if (clst == 0) {    /* Create a new chain */
+            clst = create_chain(&fp->obj, 0);
+            if (clst == 0) res = FR_DENIED;
+            if (clst == 1) res = FR_INT_ERR;
+            if (clst == 0xFFFFFFFF) res = FR_DISK_ERR;
+            if (res == FR_OK) {
+                fp->obj.sclust = clst;
+                fp->flag |= FA_MODIFIED;
+                n = 1;
+            }
+        }
+        while (res == FR_OK && n < nkeep) {     /* Follow or stretch the chain */
+            ncl = create_chain(&fp->obj, clst);
+            if (ncl == 0) res = FR_DENIED;      /* Disk full */
+            if (ncl == 1) res = FR_INT_ERR;
+            if (ncl == 0xFFFFFFFF) res = FR_DISK_ERR;
+            if (res == FR_OK) {
+                clst = ncl;
+                n++;
+            }
+        }
+        if (res == FR_OK) {     /* Remove any clusters past the last one kept */
+            ncl = get_fat(&fp->obj, clst);
+            if (ncl == 0xFFFFFFFF) res = FR_DISK_ERR;
+            if (ncl == 1) res = FR_INT_ERR;
+            if (res == FR_OK && ncl < fs->n_fatent) {
+                res = remove_chain(&fp->obj, ncl, clst);
+            }
+        }
+    }
+    if (res != FR_OK && res != FR_DENIED) ABORT(fs, res);
+
+    LEAVE_FF(fs, res);
+}
+
+
+
+
 /*-----------------------------------------------------------------------*/
 /* Delete a File/Directory                                               */
 /*-----------------------------------------------------------------------*/
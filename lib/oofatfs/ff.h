@@ -286,6 +286,8 @@ FRESULT f_read (FIL* fp, void* buff, UINT btr, UINT* br);           /* Read data
 FRESULT f_write (FIL* fp, const void* buff, UINT btw, UINT* bw);    /* Write data to the file */
 FRESULT f_lseek (FIL* fp, FSIZE_t ofs);                             /* Move file pointer of the file object */
 FRESULT f_truncate (FIL* fp);                                       /* Truncate the file */
+// CIRCUITPY-CHANGE
+FRESULT f_reserve (FIL* fp, FSIZE_t len);                           /* Reserve clusters past the file pointer */
 FRESULT f_sync (FIL* fp);                                           /* Flush cached data of the writing file */
 FRESULT f_opendir (FATFS *fs, FF_DIR* dp, const TCHAR* path);       /* Open a directory */
 FRESULT f_closedir (FF_DIR* dp);                                    /* Close an open directory */
@@ -0,0 +1,182 @@
+// Copyright 2007-2009 Russ Cox.  All Rights Reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+// CIRCUITPY-CHANGE: Pike VM over the compact bytecode.  Runs in time linear in
+// the length of the subject and in memory bounded by the size of the program,
+// unlike the backtracking engines.  Threads are kept in priority order, so the
+// match (and submatches) found is the same one recursiveloop would find.
+
+#include "re1.5.h"
+
+#ifndef re1_5_alloc
+#define re1_5_alloc(n) malloc(n)
+#define re1_5_free(p, n) free(p)
+#endif
+
+typedef struct Thread Thread;
+
+struct Thread
+{
+    const char *pc;
+    const char **sub;
+};
+
+typedef struct ThreadList ThreadList;
+
+struct ThreadList
+{
+    int n;
+    Thread t[0];
+};
+
+typedef struct PikeVM PikeVM;
+
+struct PikeVM
+{
+    const char *insts;
+    Subject *input;
+    int nsubp;
+    // Generation in which each pc was last added to a list.
+    unsigned int *mark;
+    unsigned int gen;
+};
+
+static void
+addthread(PikeVM *vm, ThreadList *l, const char *pc, const char *sp, const char **sub)
+{
+    unsigned int *mark = &vm->mark[pc - vm->insts];
+    const char *old;
+    int off;
+
+    if (*mark == vm->gen) {
+        return;
+    }
+    *mark = vm->gen;
+
+    re1_5_stack_chk();
+
+    switch (*pc) {
+    case Jmp:
+        off = (signed char)pc[1];
+        addthread(vm, l, pc + 2 + off, sp, sub);
+        return;
+    case Split:
+        off = (signed char)pc[1];
+        addthread(vm, l, pc + 2, sp, sub);
+        addthread(vm, l, pc + 2 + off, sp, sub);
+        return;
+    case RSplit:
+        off = (signed char)pc[1];
+        addthread(vm, l, pc + 2 + off, sp, sub);
+        addthread(vm, l, pc + 2, sp, sub);
+        return;
+    case Save:
+        off = (unsigned char)pc[1];
+        if (off >= vm->nsubp) {
+            addthread(vm, l, pc + 2, sp, sub);
+            return;
+        }
+        old = sub[off];
+        sub[off] = sp;
+        addthread(vm, l, pc + 2, sp, sub);
+        sub[off] = old;
+        return;
+    case Bol:
+        if (sp == vm->input->begin_line) {
+            addthread(vm, l, pc + 1, sp, sub);
+        }
+        return;
+    case Eol:
+        if (sp == vm->input->end) {
+            addthread(vm, l, pc + 1, sp, sub);
+        }
+        return;
+    }
+
+    // A consumer or Match: the thread waits here for the next step.
+    Thread *t = &l->t[l->n++];
+    t->pc = pc;
+    memcpy(t->sub, sub, vm->nsubp * sizeof(*sub));
+}
+
+int
+re1_5_pikevm(ByteProg *prog, Subject *input, const char **subp, int nsubp, int is_anchored)
+{
+    // A list can hold at most one thread per instruction.
+    int nthreads = prog->len;
+    size_t list_size = sizeof(ThreadList) + nthreads * (sizeof(Thread) + nsubp * sizeof(*subp));
+    size_t size = 2 * list_size + prog->bytelen * sizeof(unsigned int);
+    char *mem = re1_5_alloc(size);
+
+    ThreadList *clist = (ThreadList *)mem;
+    ThreadList *nlist = (ThreadList *)(mem + list_size);
+    for (int i = 0; i < nthreads; i++) {
+        clist->t[i].sub = (const char **)&clist->t[nthreads] + i * nsubp;
+        nlist->t[i].sub = (const char **)&nlist->t[nthreads] + i * nsubp;
+    }
+
+    PikeVM vm;
+    vm.insts = prog->insts;
+    vm.input = input;
+    vm.nsubp = nsubp;
+    vm.mark = (unsigned int *)(mem + 2 * list_size);
+    memset(vm.mark, 0, prog->bytelen * sizeof(unsigned int));
+    vm.gen = 1;
+
+    int matched = 0;
+    const char *sp = input->begin;
+    clist->n = 0;
+    addthread(&vm, clist, HANDLE_ANCHORED(prog->insts, is_anchored), sp, subp);
+
+    for (;;) {
+        vm.gen++;
+        nlist->n = 0;
+        for (int i = 0; i < clist->n; i++) {
+            Thread *t = &clist->t[i];
+            const char *pc = t->pc;
+            if (inst_is_consumer(*pc) && sp >= input->end) {
+                continue;
+            }
+            switch (*pc) {
+            case Char:
+                if (*sp == pc[1]) {
+                    addthread(&vm, nlist, pc + 2, sp + 1, t->sub);
+                }
+                break;
+            case Any:
+                addthread(&vm, nlist, pc + 1, sp + 1, t->sub);
+                break;
+            case Class:
+            case ClassNot:
+                if (_re1_5_classmatch(pc + 1, sp)) {
+                    addthread(&vm, nlist, pc + 2 + *(unsigned char *)(pc + 1) * 2, sp + 1, t->sub);
+                }
+                break;
+            case NamedClass:
+                if (_re1_5_namedclassmatch(pc + 1, sp)) {
+                    addthread(&vm, nlist, pc + 2, sp + 1, t->sub);
+                }
+                break;
+            case Match:
+                matched = 1;
+                memcpy(subp, t->sub, nsubp * sizeof(*subp));
+                // Lower priority threads can't win any more.
+                i = clist->n;
+                break;
+            default:
+                re1_5_fatal("pikevm");
+            }
+        }
+        if (nlist->n == 0 || sp >= input->end) {
+            break;
+        }
+        ThreadList *tmp = clist;
+        clist = nlist;
+        nlist = tmp;
+        sp++;
+    }
+
+    re1_5_free(mem, size);
+    return matched;
+}
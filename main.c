@@ -683,6 +683,7 @@ static bool __attribute__((noinline)) run_code_py(safe_mode_t safe_mode, bool *s
                 if (awoke_from_true_deep_sleep || !supervisor_workflow_active()) {
                     // Enter true deep sleep. When we wake up we'll be back at the
                     // top of main(), not in this loop.
+                    serial_flush();
                     common_hal_alarm_enter_deep_sleep();
                     // Does not return.
                 } else {
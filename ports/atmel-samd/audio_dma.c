@@ -399,7 +399,8 @@ void audio_dma_evsys_handler(void) {
             continue;
         }
 
-        background_callback_add(&dma->callback, dma_callback_fun, (void *)dma);
+        dma->callback.budget_us = BACKGROUND_CALLBACK_AUDIO_BUDGET_US;
+        background_callback_add_with_priority(&dma->callback, dma_callback_fun, (void *)dma, BACKGROUND_CALLBACK_PRIORITY_AUDIO);
     }
 }
 
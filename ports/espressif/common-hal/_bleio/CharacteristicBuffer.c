@@ -21,12 +21,21 @@
 
 #include "common-hal/_bleio/ble_events.h"
 
+#include "freertos/FreeRTOS.h"
+
+// Dropping pending bytes on ctrl-C moves the write position back under the
+// reader, so it and the reader's gets must not overlap. The BLE host task may
+// run on the other core, so this is a spinlock rather than an interrupt mask.
+static portMUX_TYPE ringbuf_mutex = portMUX_INITIALIZER_UNLOCKED;
+
 void bleio_characteristic_buffer_extend(bleio_characteristic_buffer_obj_t *self, const uint8_t *data, size_t len) {
     if (self->watch_for_interrupt_char) {
         for (uint16_t i = 0; i < len; i++) {
             if (data[i] == mp_interrupt_char) {
                 mp_sched_keyboard_interrupt();
-                ringbuf_clear(&self->ringbuf);
+                portENTER_CRITICAL(&ringbuf_mutex);
+                ringbuf_drop_pending(&self->ringbuf);
+                portEXIT_CRITICAL(&ringbuf_mutex);
             } else {
                 ringbuf_put(&self->ringbuf, data[i]);
             }
@@ -70,20 +79,20 @@ uint32_t common_hal_bleio_characteristic_buffer_read(bleio_characteristic_buffer
         }
     }
 
+    portENTER_CRITICAL(&ringbuf_mutex);
     uint32_t num_bytes_read = ringbuf_get_n(&self->ringbuf, data, len);
+    portEXIT_CRITICAL(&ringbuf_mutex);
     return num_bytes_read;
 }
 
-// NOTE: The nRF port has protection around these operations because the ringbuf
-// is filled from an interrupt. On ESP the ringbuf is filled from the BLE host
-// task that won't interrupt us.
-
 uint32_t common_hal_bleio_characteristic_buffer_rx_characters_available(bleio_characteristic_buffer_obj_t *self) {
     return ringbuf_num_filled(&self->ringbuf);
 }
 
 void common_hal_bleio_characteristic_buffer_clear_rx_buffer(bleio_characteristic_buffer_obj_t *self) {
+    portENTER_CRITICAL(&ringbuf_mutex);
     ringbuf_clear(&self->ringbuf);
+    portEXIT_CRITICAL(&ringbuf_mutex);
 }
 
 bool common_hal_bleio_characteristic_buffer_deinited(bleio_characteristic_buffer_obj_t *self) {
@@ -110,7 +110,8 @@ static bool i2s_event_interrupt(i2s_chan_handle_t handle, i2s_event_data_t *even
     self->underrun = self->underrun || self->next_buffer != NULL;
     self->next_buffer = *(int16_t **)event->dma_buf;
     self->next_buffer_size = event->size;
-    background_callback_add(&self->callback, i2s_callback_fun, self_in);
+    self->callback.budget_us = BACKGROUND_CALLBACK_AUDIO_BUDGET_US;
+    background_callback_add_with_priority(&self->callback, i2s_callback_fun, self_in, BACKGROUND_CALLBACK_PRIORITY_AUDIO);
     return false;
 }
 
@@ -46,7 +46,9 @@ static void _copy_out_of_fifo(void) {
     for (size_t i = 0; i < len; ++i) {
         if (rx_buf[i] == mp_interrupt_char) {
             mp_sched_keyboard_interrupt();
-            ringbuf_clear(&ringbuf);
+            // Safe here: usb_serial_jtag_read_char() only gets with interrupts
+            // disabled or with the receive interrupt masked.
+            ringbuf_drop_pending(&ringbuf);
         } else {
             ringbuf_put(&ringbuf, rx_buf[i]);
         }
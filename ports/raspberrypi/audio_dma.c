@@ -554,7 +554,8 @@ static void __not_in_flash_func(audio_dma_irq_handler)(void) {
         // Disable the channel so that we don't play it without filling it.
         dma_hw->ch[i].al1_ctrl &= ~DMA_CH0_CTRL_TRIG_EN_BITS;
         // This is a noop if the callback is already queued.
-        background_callback_add(&dma->callback, dma_callback_fun, (void *)dma);
+        dma->callback.budget_us = BACKGROUND_CALLBACK_AUDIO_BUDGET_US;
+        background_callback_add_with_priority(&dma->callback, dma_callback_fun, (void *)dma, BACKGROUND_CALLBACK_PRIORITY_AUDIO);
     }
 }
 
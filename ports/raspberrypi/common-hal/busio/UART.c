@@ -81,13 +81,23 @@ static uint8_t pin_init(const uint8_t uart, const mcu_pin_obj_t *pin, const uint
 static busio_uart_obj_t *active_uarts[NUM_UARTS];
 
 static void _copy_into_ringbuf(ringbuf_t *r, uart_inst_t *uart) {
-    while (uart_is_readable(uart) && ringbuf_num_empty(r) > 0) {
-        ringbuf_put(r, (uint8_t)uart_get_hw(uart)->dr);
+    // Drain the FIFO straight into the ringbuf, publishing each run of bytes
+    // at once.
+    uint8_t *space;
+    size_t available;
+    while (uart_is_readable(uart) && (available = ringbuf_reserve_contiguous(r, &space)) > 0) {
+        size_t count = 0;
+        while (count < available && uart_is_readable(uart)) {
+            space[count++] = (uint8_t)uart_get_hw(uart)->dr;
+        }
+        ringbuf_commit(r, count);
     }
 }
 
 static void shared_callback(busio_uart_obj_t *self) {
     _copy_into_ringbuf(&self->ringbuf, self->uart);
+    // Tell select.poll there is data to read.
+    mp_stream_poll_notify(MP_OBJ_FROM_PTR(self));
     // We always clear the interrupt so it doesn't continue to fire because we
     // may not have read everything available.
     uart_get_hw(self->uart)->icr = UART_UARTICR_RXIC_BITS | UART_UARTICR_RTIC_BITS;
@@ -180,6 +180,8 @@ static inline void exec_user_callback(socketpool_socket_obj_t *socket) {
     }
     #endif
     supervisor_workflow_request_background();
+    // Tell select.poll the socket may have become readable.
+    mp_stream_poll_notify(MP_OBJ_FROM_PTR(socket));
 }
 
 #if MICROPY_PY_LWIP_SOCK_RAW
@@ -197,6 +199,7 @@ static u8_t _lwip_raw_incoming(void *arg, struct raw_pcb *pcb, struct pbuf *p, c
     } else {
         socket->incoming.pbuf = p;
         memcpy(&socket->peer, addr, sizeof(socket->peer));
+        mp_stream_poll_notify(MP_OBJ_FROM_PTR(socket));
     }
     return 1; // we ate the packet
 }
@@ -219,6 +222,7 @@ static void _lwip_udp_incoming(void *arg, struct udp_pcb *upcb, struct pbuf *p,
         socket->incoming.pbuf = p;
         socket->peer_port = (mp_uint_t)port;
         memcpy(&socket->peer, addr, sizeof(socket->peer));
+        mp_stream_poll_notify(MP_OBJ_FROM_PTR(socket));
     }
 }
 
@@ -232,6 +236,7 @@ static void _lwip_tcp_error(void *arg, err_t err) {
     socket->state = err;
     // If we got here, the lwIP stack either has deallocated or will deallocate the pcb.
     socket->pcb.tcp = NULL;
+    mp_stream_poll_notify(MP_OBJ_FROM_PTR(socket));
 }
 
 // Callback for tcp connection requests. Error code err is unused. (See tcp.h)
@@ -239,6 +244,16 @@ static err_t _lwip_tcp_connected(void *arg, struct tcp_pcb *tpcb, err_t err) {
     socketpool_socket_obj_t *socket = (socketpool_socket_obj_t *)arg;
 
     socket->state = STATE_CONNECTED;
+    mp_stream_poll_notify(MP_OBJ_FROM_PTR(socket));
+    return ERR_OK;
+}
+
+// Callback for acknowledged tcp data, which frees space in the send buffer.
+static err_t _lwip_tcp_sent(void *arg, struct tcp_pcb *tpcb, u16_t len) {
+    socketpool_socket_obj_t *socket = (socketpool_socket_obj_t *)arg;
+
+    // Tell select.poll the socket may have become writable.
+    mp_stream_poll_notify(MP_OBJ_FROM_PTR(socket));
     return ERR_OK;
 }
 
@@ -844,6 +859,7 @@ int socketpool_socket_accept(socketpool_socket_obj_t *self, mp_obj_t *peer_out,
     tcp_arg(accepted->pcb.tcp, (void *)accepted);
     tcp_err(accepted->pcb.tcp, _lwip_tcp_error);
     tcp_recv(accepted->pcb.tcp, _lwip_tcp_recv);
+    tcp_sent(accepted->pcb.tcp, _lwip_tcp_sent);
 
     tcp_accepted(listener);
 
@@ -943,6 +959,7 @@ void socketpool_socket_close(socketpool_socket_obj_t *socket) {
             if (socket->pcb.tcp->state != LISTEN) {
                 tcp_err(socket->pcb.tcp, NULL);
                 tcp_recv(socket->pcb.tcp, NULL);
+                tcp_sent(socket->pcb.tcp, NULL);
 
                 // Schedule a callback to abort the connection if it's not cleanly closed after
                 // the given timeout.  The callback must be set before calling tcp_close since
@@ -1002,6 +1019,7 @@ void common_hal_socketpool_socket_connect(socketpool_socket_obj_t *socket,
             MICROPY_PY_LWIP_ENTER
             tcp_recv(socket->pcb.tcp, _lwip_tcp_recv);
             tcp_err(socket->pcb.tcp, _lwip_tcp_error);
+            tcp_sent(socket->pcb.tcp, _lwip_tcp_sent);
             socket->state = STATE_CONNECTING;
             err = tcp_connect(socket->pcb.tcp, &dest, port, _lwip_tcp_connected);
             if (err != ERR_OK) {
@@ -1308,12 +1326,14 @@ void socketpool_socket_move(socketpool_socket_obj_t *self, socketpool_socket_obj
     tcp_arg(self->pcb.tcp, NULL);
     tcp_err(self->pcb.tcp, NULL);
     tcp_recv(self->pcb.tcp, NULL);
+    tcp_sent(self->pcb.tcp, NULL);
 
     self->pcb.tcp = NULL;
 
     tcp_arg(sock->pcb.tcp, (void *)sock);
     tcp_err(sock->pcb.tcp, _lwip_tcp_error);
     tcp_recv(sock->pcb.tcp, _lwip_tcp_recv);
+    tcp_sent(sock->pcb.tcp, _lwip_tcp_sent);
 
     MICROPY_PY_LWIP_EXIT;
 }
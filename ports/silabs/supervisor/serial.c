@@ -67,7 +67,8 @@ void EUSART0_RX_IRQHandler(void) {
 
     if (received_data == CHAR_CTRL_C &&
         mp_interrupt_char == CHAR_CTRL_C) {
-        ringbuf_clear(&con_uart_rx_ringbuf);
+        // port_serial_read() gets with interrupts disabled.
+        ringbuf_drop_pending(&con_uart_rx_ringbuf);
         mp_sched_keyboard_interrupt();
     }
     EUSART_IntClear(EUSART0, EUSART_IF_RXFL);
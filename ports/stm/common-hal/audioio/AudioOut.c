@@ -312,16 +312,18 @@ void DMA1_Stream6_IRQHandler(void) {
 void HAL_DAC_ConvHalfCpltCallbackCh1(DAC_HandleTypeDef *hdac) {
     if (active_audioout && !active_audioout->paused) {
         active_audioout->halves_to_fill |= 0x1;
-        background_callback_add(&active_audioout->callback,
-            audioout_fill_callback, active_audioout);
+        active_audioout->callback.budget_us = BACKGROUND_CALLBACK_AUDIO_BUDGET_US;
+        background_callback_add_with_priority(&active_audioout->callback,
+            audioout_fill_callback, active_audioout, BACKGROUND_CALLBACK_PRIORITY_AUDIO);
     }
 }
 
 void HAL_DAC_ConvCpltCallbackCh1(DAC_HandleTypeDef *hdac) {
     if (active_audioout && !active_audioout->paused) {
         active_audioout->halves_to_fill |= 0x2;
-        background_callback_add(&active_audioout->callback,
-            audioout_fill_callback, active_audioout);
+        active_audioout->callback.budget_us = BACKGROUND_CALLBACK_AUDIO_BUDGET_US;
+        background_callback_add_with_priority(&active_audioout->callback,
+            audioout_fill_callback, active_audioout, BACKGROUND_CALLBACK_PRIORITY_AUDIO);
     }
 }
 
@@ -0,0 +1,15 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2025 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+// Only the types needed to build the supervisor flash layer for flashsim.
+
+#include "py/obj.h"
+
+typedef struct {
+    mp_obj_base_t base;
+} busio_spi_obj_t;
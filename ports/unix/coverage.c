@@ -19,6 +19,11 @@
 #include "py/stream.h"
 #include "py/binary.h"
 #include "py/bc.h"
+// CIRCUITPY-CHANGE: test TileGrid scrolling
+#include "shared-bindings/displayio/Bitmap.h"
+#include "shared-bindings/displayio/Palette.h"
+#include "shared-bindings/displayio/TileGrid.h"
+#include "shared-bindings/tilepalettemapper/TilePaletteMapper.h"
 
 // expected output of this file is found in extra_coverage.py.exp
 
@@ -147,6 +152,80 @@ static MP_DEFINE_CONST_OBJ_TYPE(
     locals_dict, &rawfile_locals_dict2
     );
 
+// CIRCUITPY-CHANGE: stream that notifies select.poll when it may have become
+// ready, registered as the global PollNotifyStream
+typedef struct _mp_obj_stest_notify_t {
+    mp_obj_base_t base;
+    mp_uint_t ready;
+    mp_uint_t poll_count;
+    bool closed;
+} mp_obj_stest_notify_t;
+
+const mp_obj_type_t mp_type_stest_notify;
+
+static mp_obj_t stest_notify_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    mp_arg_check_num(n_args, n_kw, 0, 0, false);
+    mp_obj_stest_notify_t *o = mp_obj_malloc(mp_obj_stest_notify_t, type);
+    o->ready = 0;
+    o->poll_count = 0;
+    o->closed = false;
+    return MP_OBJ_FROM_PTR(o);
+}
+
+// Set the events the stream is ready for and notify select.poll.
+static mp_obj_t stest_notify_set_ready(mp_obj_t o_in, mp_obj_t ready_in) {
+    mp_obj_stest_notify_t *o = MP_OBJ_TO_PTR(o_in);
+    o->ready = mp_obj_get_int(ready_in);
+    mp_stream_poll_notify(o_in);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(stest_notify_set_ready_obj, stest_notify_set_ready);
+
+// Return how many times select.poll has called the MP_STREAM_POLL ioctl.
+static mp_obj_t stest_notify_poll_count(mp_obj_t o_in) {
+    mp_obj_stest_notify_t *o = MP_OBJ_TO_PTR(o_in);
+    return mp_obj_new_int_from_uint(o->poll_count);
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(stest_notify_poll_count_obj, stest_notify_poll_count);
+
+static mp_uint_t stest_notify_ioctl(mp_obj_t o_in, mp_uint_t request, uintptr_t arg, int *errcode) {
+    mp_obj_stest_notify_t *o = MP_OBJ_TO_PTR(o_in);
+    if (request == MP_STREAM_POLL) {
+        o->poll_count += 1;
+        if (o->closed) {
+            return MP_STREAM_POLL_NVAL;
+        }
+        return o->ready & arg;
+    } else if (request == MP_STREAM_CLOSE) {
+        o->closed = true;
+        return 0;
+    }
+    *errcode = MP_EINVAL;
+    return MP_STREAM_ERROR;
+}
+
+static const mp_rom_map_elem_t stest_notify_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_set_ready), MP_ROM_PTR(&stest_notify_set_ready_obj) },
+    { MP_ROM_QSTR(MP_QSTR_poll_count), MP_ROM_PTR(&stest_notify_poll_count_obj) },
+    { MP_ROM_QSTR(MP_QSTR_close), MP_ROM_PTR(&mp_stream_close_obj) },
+};
+
+static MP_DEFINE_CONST_DICT(stest_notify_locals_dict, stest_notify_locals_dict_table);
+
+static const mp_stream_p_t stest_notify_stream_p = {
+    .ioctl = stest_notify_ioctl,
+    .poll_notify = MP_STREAM_POLL_RD | MP_STREAM_POLL_WR,
+};
+
+MP_DEFINE_CONST_OBJ_TYPE(
+    mp_type_stest_notify,
+    MP_QSTR_PollNotifyStream,
+    MP_TYPE_FLAG_NONE,
+    make_new, stest_notify_make_new,
+    protocol, &stest_notify_stream_p,
+    locals_dict, &stest_notify_locals_dict
+    );
+
 // str/bytes objects without a valid hash
 static const mp_obj_str_t str_no_hash_obj = {{&mp_type_str}, 0, 10, (const byte *)"0123456789"};
 static const mp_obj_str_t bytes_no_hash_obj = {{&mp_type_bytes}, 0, 10, (const byte *)"0123456789"};
@@ -803,6 +882,38 @@ static mp_obj_t extra_coverage(void) {
         ringbuf_clear(&ringbuf);
         ringbuf_put(&ringbuf, 0xaa);
         mp_printf(&mp_plat_print, "%d\n", ringbuf_get16(&ringbuf));
+
+        // Bulk put/get that wraps around the end of the buffer.
+        ringbuf_clear(&ringbuf);
+        byte data[RINGBUF_SIZE + 1];
+        for (int i = 0; i < RINGBUF_SIZE + 1; ++i) {
+            data[i] = i;
+        }
+        mp_printf(&mp_plat_print, "%d\n", (int)ringbuf_put_n(&ringbuf, data, 60));
+        mp_printf(&mp_plat_print, "%d\n", (int)ringbuf_get_n(&ringbuf, data, 60));
+        mp_printf(&mp_plat_print, "%d\n", (int)ringbuf_put_n(&ringbuf, data, RINGBUF_SIZE + 1));
+        mp_printf(&mp_plat_print, "%d %d\n", (int)ringbuf_num_empty(&ringbuf), (int)ringbuf_num_filled(&ringbuf));
+        memset(data, 0, sizeof(data));
+        mp_printf(&mp_plat_print, "%d\n", (int)ringbuf_get_n(&ringbuf, data, RINGBUF_SIZE + 1));
+        mp_printf(&mp_plat_print, "%d %d %d\n", data[0], data[38], data[RINGBUF_SIZE - 1]);
+
+        // Zero-copy access stops at the end of the buffer.
+        uint8_t *space;
+        const uint8_t *filled;
+        mp_printf(&mp_plat_print, "%d\n", (int)ringbuf_reserve_contiguous(&ringbuf, &space));
+        space[0] = 0x5a;
+        ringbuf_commit(&ringbuf, 1);
+        mp_printf(&mp_plat_print, "%d\n", (int)ringbuf_peek_contiguous(&ringbuf, &filled));
+        mp_printf(&mp_plat_print, "%02x\n", filled[0]);
+        ringbuf_skip(&ringbuf, 1);
+        mp_printf(&mp_plat_print, "%d %d\n", (int)ringbuf_num_empty(&ringbuf), (int)ringbuf_num_filled(&ringbuf));
+
+        // Producer-side drop of bytes not yet gotten.
+        ringbuf_put16(&ringbuf, 0x1234);
+        ringbuf_drop_pending(&ringbuf);
+        mp_printf(&mp_plat_print, "%d %d\n", (int)ringbuf_num_empty(&ringbuf), (int)ringbuf_num_filled(&ringbuf));
+        ringbuf_put(&ringbuf, 0x77);
+        mp_printf(&mp_plat_print, "%02x\n", ringbuf_get(&ringbuf));
     }
 
     // pairheap
@@ -877,6 +988,45 @@ static mp_obj_t extra_coverage(void) {
             MICROPY_STACK_CHECK == 0 || old_stack_limit == new_stack_limit);
     }
 
+    // CIRCUITPY-CHANGE: scrolling a TileGrid only redraws tiles that changed
+    {
+        mp_printf(&mp_plat_print, "# tilegrid\n");
+
+        // Every tile shows the same blank 2x2 tile, so only colors mapped by
+        // grid position can change when scrolling.
+        displayio_bitmap_t *bitmap = mp_obj_malloc(displayio_bitmap_t, &displayio_bitmap_type);
+        common_hal_displayio_bitmap_construct(bitmap, 4, 2, 1);
+        displayio_palette_t *palette = mp_obj_malloc(displayio_palette_t, &displayio_palette_type);
+        common_hal_displayio_palette_construct(palette, 2, false);
+        tilepalettemapper_tilepalettemapper_t *mapper = mp_obj_malloc(tilepalettemapper_tilepalettemapper_t, &tilepalettemapper_tilepalettemapper_type);
+        common_hal_tilepalettemapper_tilepalettemapper_construct(mapper, MP_OBJ_FROM_PTR(palette), 2);
+
+        mp_obj_t shaders[] = {MP_OBJ_FROM_PTR(palette), MP_OBJ_FROM_PTR(mapper)};
+        for (size_t i = 0; i < MP_ARRAY_SIZE(shaders); i++) {
+            displayio_tilegrid_t *grid = mp_obj_malloc(displayio_tilegrid_t, &displayio_tilegrid_type);
+            common_hal_displayio_tilegrid_construct(grid, MP_OBJ_FROM_PTR(bitmap), 2, 1, shaders[i], 2, 2, 2, 2, 0, 0, 0);
+            displayio_area_t rows[2];
+            displayio_tilegrid_set_dirty_rows(grid, rows);
+            displayio_tilegrid_update_transform(grid, &null_transform);
+            if (shaders[i] == MP_OBJ_FROM_PTR(mapper)) {
+                mp_obj_t swapped[] = {MP_OBJ_NEW_SMALL_INT(1), MP_OBJ_NEW_SMALL_INT(0)};
+                common_hal_tilepalettemapper_tilepalettemapper_set_mapping(mapper, 0, 0, 2, swapped);
+            }
+            displayio_tilegrid_get_refresh_areas(grid, NULL);
+            displayio_tilegrid_finish_refresh(grid);
+
+            common_hal_displayio_tilegrid_set_top_left(grid, 1, 0);
+            displayio_area_t *area = displayio_tilegrid_get_refresh_areas(grid, NULL);
+            if (area == NULL) {
+                mp_printf(&mp_plat_print, "none\n");
+            } else {
+                mp_printf(&mp_plat_print, "%d %d %d %d\n", area->x1, area->y1, area->x2, area->y2);
+            }
+            displayio_tilegrid_finish_refresh(grid);
+            displayio_tilegrid_set_dirty_rows(grid, NULL);
+        }
+    }
+
     mp_printf(&mp_plat_print, "# end coverage.c\n");
 
     mp_obj_streamtest_t *s = mp_obj_malloc(mp_obj_streamtest_t, &mp_type_stest_fileio);
@@ -11,7 +11,9 @@
 #include "shared-bindings/displayio/__init__.h"
 #include "shared-bindings/displayio/Bitmap.h"
 #include "shared-bindings/displayio/ColorConverter.h"
+#include "shared-bindings/displayio/OnDiskBitmap.h"
 #include "shared-bindings/displayio/Palette.h"
+#include "shared-bindings/displayio/TileGrid.h"
 
 MAKE_ENUM_VALUE(displayio_colorspace_type, displayio_colorspace, RGB888, DISPLAYIO_COLORSPACE_RGB888);
 MAKE_ENUM_VALUE(displayio_colorspace_type, displayio_colorspace, RGB565, DISPLAYIO_COLORSPACE_RGB565);
@@ -59,12 +61,21 @@ static MP_DEFINE_CONST_DICT(displayio_colorspace_locals_dict, displayio_colorspa
 MAKE_PRINTER(displayio, displayio_colorspace);
 MAKE_ENUM_TYPE(displayio, ColorSpace, displayio_colorspace);
 
+// OnDiskBitmap's binding needs FAT file objects, which this port doesn't have.
+// TileGrid checks for the type, so provide one that can't be constructed.
+MP_DEFINE_CONST_OBJ_TYPE(
+    displayio_ondiskbitmap_type,
+    MP_QSTR_OnDiskBitmap,
+    MP_TYPE_FLAG_NONE
+    );
+
 static const mp_rom_map_elem_t displayio_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_displayio) },
     { MP_ROM_QSTR(MP_QSTR_Bitmap), MP_ROM_PTR(&displayio_bitmap_type) },
     { MP_ROM_QSTR(MP_QSTR_Colorspace), MP_ROM_PTR(&displayio_colorspace_type) },
     { MP_ROM_QSTR(MP_QSTR_ColorConverter), MP_ROM_PTR(&displayio_colorconverter_type) },
     { MP_ROM_QSTR(MP_QSTR_Palette), MP_ROM_PTR(&displayio_palette_type) },
+    { MP_ROM_QSTR(MP_QSTR_TileGrid), MP_ROM_PTR(&displayio_tilegrid_type) },
 };
 static MP_DEFINE_CONST_DICT(displayio_module_globals, displayio_module_globals_table);
 
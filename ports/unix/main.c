@@ -584,6 +584,9 @@ MP_NOINLINE int main_(int argc, char **argv) {
         // CIRCUITPY-CHANGE: test native base classes work as needed by CircuitPython libraries.
         extern const mp_obj_type_t native_base_class_type;
         mp_store_global(MP_QSTR_NativeBaseClass, MP_OBJ_FROM_PTR(&native_base_class_type));
+        // CIRCUITPY-CHANGE: test streams that notify select.poll.
+        extern const mp_obj_type_t mp_type_stest_notify;
+        mp_store_global(MP_QSTR_PollNotifyStream, MP_OBJ_FROM_PTR(&mp_type_stest_notify));
     }
     #endif
 
@@ -0,0 +1,195 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2025 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+// Runs the external flash layer of the supervisor against a simulated NOR
+// flash, so that its caching can be measured and tested off-device. The module
+// itself is a block device that can be passed to os.VfsFat.
+
+#include <stdlib.h>
+
+#include "py/obj.h"
+#include "py/runtime.h"
+#include "extmod/vfs.h"
+
+#if MICROPY_PY_FLASHSIM
+
+#include "shared-bindings/microcontroller/__init__.h"
+#include "supervisor/flash.h"
+#include "supervisor/port_heap.h"
+#include "supervisor/shared/external_flash/sim_flash.h"
+
+static bool flashsim_initialized;
+// Bytes that port_malloc() may hand out, to simulate the RAM a board has
+// available for the flash cache.
+static size_t flashsim_ram_limit = SIZE_MAX;
+static size_t flashsim_ram_used;
+
+void *port_malloc(size_t size, bool dma_capable) {
+    (void)dma_capable;
+    if (size > flashsim_ram_limit - flashsim_ram_used) {
+        return NULL;
+    }
+    size_t *block = malloc(sizeof(size_t) + size);
+    if (block == NULL) {
+        return NULL;
+    }
+    *block = size;
+    flashsim_ram_used += size;
+    return block + 1;
+}
+
+void port_free(void *ptr) {
+    if (ptr == NULL) {
+        return;
+    }
+    size_t *block = (size_t *)ptr - 1;
+    flashsim_ram_used -= *block;
+    free(block);
+}
+
+void common_hal_mcu_delay_us(uint32_t delay) {
+    sim_flash_delay_us(delay);
+}
+
+static bool flashsim_start(const sim_flash_config_t *config, size_t ram_limit) {
+    // Write back and free the cache of any earlier run before starting over.
+    if (flashsim_initialized) {
+        supervisor_flash_release_cache();
+    }
+    if (!sim_flash_configure(config)) {
+        return false;
+    }
+    flashsim_ram_limit = ram_limit;
+    supervisor_flash_init();
+    sim_flash_reset_stats();
+    flashsim_initialized = true;
+    return true;
+}
+
+// Start with the default device if init() wasn't called.
+static void flashsim_check_initialized(void) {
+    if (!flashsim_initialized) {
+        const sim_flash_config_t config = {
+            .page_size = 256,
+            .erase_size = 4096,
+            .page_program_us = 700,
+            .sector_erase_us = 45000,
+            .bytes_per_us = 4,
+        };
+        flashsim_start(&config, SIZE_MAX);
+    }
+}
+
+static mp_obj_t flashsim_init(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_page_size, ARG_erase_size, ARG_page_program_us, ARG_sector_erase_us, ARG_bytes_per_us, ARG_ram };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_page_size, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 256} },
+        { MP_QSTR_erase_size, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 4096} },
+        { MP_QSTR_page_program_us, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 700} },
+        { MP_QSTR_sector_erase_us, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 45000} },
+        { MP_QSTR_bytes_per_us, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 4} },
+        { MP_QSTR_ram, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = -1} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    const sim_flash_config_t config = {
+        .page_size = mp_arg_validate_int_min(args[ARG_page_size].u_int, 1, MP_QSTR_page_size),
+        .erase_size = mp_arg_validate_int_min(args[ARG_erase_size].u_int, 1, MP_QSTR_erase_size),
+        .page_program_us = mp_arg_validate_int_min(args[ARG_page_program_us].u_int, 0, MP_QSTR_page_program_us),
+        .sector_erase_us = mp_arg_validate_int_min(args[ARG_sector_erase_us].u_int, 0, MP_QSTR_sector_erase_us),
+        .bytes_per_us = mp_arg_validate_int_min(args[ARG_bytes_per_us].u_int, 1, MP_QSTR_bytes_per_us),
+    };
+
+    size_t ram_limit = args[ARG_ram].u_int < 0 ? SIZE_MAX : (size_t)args[ARG_ram].u_int;
+    if (!flashsim_start(&config, ram_limit)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("Invalid size"));
+    }
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(flashsim_init_obj, 0, flashsim_init);
+
+static mp_obj_t flashsim_readblocks(mp_obj_t block_num_in, mp_obj_t buf_in) {
+    flashsim_check_initialized();
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buf_in, &bufinfo, MP_BUFFER_WRITE);
+    mp_uint_t ret = supervisor_flash_read_blocks(bufinfo.buf, mp_obj_get_int(block_num_in), bufinfo.len / FILESYSTEM_BLOCK_SIZE);
+    return MP_OBJ_NEW_SMALL_INT(ret);
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(flashsim_readblocks_obj, flashsim_readblocks);
+
+static mp_obj_t flashsim_writeblocks(mp_obj_t block_num_in, mp_obj_t buf_in) {
+    flashsim_check_initialized();
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buf_in, &bufinfo, MP_BUFFER_READ);
+    mp_uint_t ret = supervisor_flash_write_blocks(bufinfo.buf, mp_obj_get_int(block_num_in), bufinfo.len / FILESYSTEM_BLOCK_SIZE);
+    return MP_OBJ_NEW_SMALL_INT(ret);
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(flashsim_writeblocks_obj, flashsim_writeblocks);
+
+static mp_obj_t flashsim_ioctl(mp_obj_t op_in, mp_obj_t arg_in) {
+    flashsim_check_initialized();
+    switch (mp_obj_get_int(op_in)) {
+        case MP_BLOCKDEV_IOCTL_DEINIT:
+            supervisor_flash_release_cache();
+            return MP_OBJ_NEW_SMALL_INT(0);
+        case MP_BLOCKDEV_IOCTL_SYNC:
+            supervisor_external_flash_flush();
+            return MP_OBJ_NEW_SMALL_INT(0);
+        case MP_BLOCKDEV_IOCTL_BLOCK_COUNT:
+            return MP_OBJ_NEW_SMALL_INT(supervisor_flash_get_block_count());
+        case MP_BLOCKDEV_IOCTL_BLOCK_SIZE:
+            return MP_OBJ_NEW_SMALL_INT(supervisor_flash_get_block_size());
+        case MP_BLOCKDEV_IOCTL_INIT:
+        case MP_BLOCKDEV_IOCTL_BLOCK_ERASE:
+            return MP_OBJ_NEW_SMALL_INT(0);
+        default:
+            return mp_const_none;
+    }
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(flashsim_ioctl_obj, flashsim_ioctl);
+
+// Returns a dict of the counters since init() or reset_stats().
+static mp_obj_t flashsim_stats(void) {
+    sim_flash_stats_t stats;
+    sim_flash_get_stats(&stats);
+    mp_obj_t dict = mp_obj_new_dict(7);
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_sector_erases), mp_obj_new_int_from_uint(stats.sector_erases));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_page_programs), mp_obj_new_int_from_uint(stats.page_programs));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_bytes_programmed), mp_obj_new_int_from_uint(stats.bytes_programmed));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_bytes_read), mp_obj_new_int_from_uint(stats.bytes_read));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_max_region_erases), mp_obj_new_int_from_uint(stats.max_region_erases));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_program_errors), mp_obj_new_int_from_uint(stats.program_errors));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_elapsed_us), mp_obj_new_int_from_ull(stats.elapsed_us));
+    return dict;
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(flashsim_stats_obj, flashsim_stats);
+
+static mp_obj_t flashsim_reset_stats(void) {
+    sim_flash_reset_stats();
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(flashsim_reset_stats_obj, flashsim_reset_stats);
+
+static const mp_rom_map_elem_t flashsim_module_globals_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_flashsim) },
+    { MP_ROM_QSTR(MP_QSTR_init), MP_ROM_PTR(&flashsim_init_obj) },
+    { MP_ROM_QSTR(MP_QSTR_readblocks), MP_ROM_PTR(&flashsim_readblocks_obj) },
+    { MP_ROM_QSTR(MP_QSTR_writeblocks), MP_ROM_PTR(&flashsim_writeblocks_obj) },
+    { MP_ROM_QSTR(MP_QSTR_ioctl), MP_ROM_PTR(&flashsim_ioctl_obj) },
+    { MP_ROM_QSTR(MP_QSTR_stats), MP_ROM_PTR(&flashsim_stats_obj) },
+    { MP_ROM_QSTR(MP_QSTR_reset_stats), MP_ROM_PTR(&flashsim_reset_stats_obj) },
+};
+static MP_DEFINE_CONST_DICT(flashsim_module_globals, flashsim_module_globals_table);
+
+const mp_obj_module_t flashsim_module = {
+    .base = { &mp_type_module },
+    .globals = (mp_obj_dict_t *)&flashsim_module_globals,
+};
+
+MP_REGISTER_MODULE(MP_QSTR_flashsim, flashsim_module);
+
+#endif // MICROPY_PY_FLASHSIM
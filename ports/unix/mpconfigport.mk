@@ -40,6 +40,9 @@ MICROPY_SSL_MBEDTLS = 0
 # jni module requires JVM/JNI
 MICROPY_PY_JNI = 0
 
+# CIRCUITPY-CHANGE: flashsim module, the external flash layer on a simulated flash
+MICROPY_PY_FLASHSIM = 0
+
 # Avoid using system libraries, use copies bundled with MicroPython
 # as submodules (currently affects only libffi).
 MICROPY_STANDALONE ?= 0
@@ -56,9 +56,11 @@ SRC_BITMAP := \
 	shared-bindings/displayio/Bitmap.c \
 	shared-bindings/displayio/ColorConverter.c \
 	shared-bindings/displayio/Palette.c \
+	shared-bindings/displayio/TileGrid.c \
 	shared-bindings/floppyio/__init__.c \
 	shared-bindings/jpegio/__init__.c \
 	shared-bindings/jpegio/JpegDecoder.c \
+	shared-bindings/jpegio/MjpegPlayer.c \
 	shared-bindings/locale/__init__.c \
 	shared-bindings/rainbowio/__init__.c \
 	shared-bindings/struct/__init__.c \
@@ -69,6 +71,8 @@ SRC_BITMAP := \
 	shared-bindings/synthio/Note.c \
 	shared-bindings/synthio/Biquad.c \
 	shared-bindings/synthio/Synthesizer.c \
+	shared-bindings/tilepalettemapper/__init__.c \
+	shared-bindings/tilepalettemapper/TilePaletteMapper.c \
 	shared-bindings/traceback/__init__.c \
 	shared-bindings/util.c \
 	shared-bindings/vectorio/Circle.c \
@@ -102,10 +106,13 @@ SRC_BITMAP := \
 	shared-module/displayio/area.c \
 	shared-module/displayio/Bitmap.c \
 	shared-module/displayio/ColorConverter.c \
+	shared-module/displayio/OnDiskBitmap.c \
 	shared-module/displayio/Palette.c \
+	shared-module/displayio/TileGrid.c \
 	shared-module/floppyio/__init__.c \
 	shared-module/jpegio/__init__.c \
 	shared-module/jpegio/JpegDecoder.c \
+	shared-module/jpegio/MjpegPlayer.c \
 	shared-module/rainbowio/__init__.c \
 	shared-module/struct/__init__.c \
 	shared-module/synthio/__init__.c \
@@ -115,6 +122,7 @@ SRC_BITMAP := \
 	shared-module/synthio/Note.c \
 	shared-module/synthio/Biquad.c \
 	shared-module/synthio/Synthesizer.c \
+	shared-module/tilepalettemapper/TilePaletteMapper.c \
 	shared-bindings/vectorio/Circle.c \
 	shared-module/vectorio/Circle.c \
 	shared-module/vectorio/__init__.c \
@@ -168,11 +176,15 @@ CFLAGS += \
 	-DCIRCUITPY_STRUCT=1 \
 	-DCIRCUITPY_SYNTHIO=1 \
 	-DCIRCUITPY_SYNTHIO_MAX_CHANNELS=14 \
+	-DCIRCUITPY_TILEPALETTEMAPPER=1 \
 	-DCIRCUITPY_TRACEBACK=1 \
 	-DCIRCUITPY_VECTORIO=1 \
 	-DCIRCUITPY_ZLIB=1
 
 # CIRCUITPY-CHANGE: test native base classes.
 SRC_C += coverage.c native_base_class.c
+
+# CIRCUITPY-CHANGE: test the external flash layer on a simulated flash.
+MICROPY_PY_FLASHSIM = 1
 SRC_CXX += coveragecpp.cpp
 CIRCUITPY_MESSAGE_COMPRESSION_LEVEL = 1
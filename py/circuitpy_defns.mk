@@ -779,6 +779,7 @@ SRC_SHARED_MODULE_ALL = \
 	is31fl3741/__init__.c \
 	jpegio/__init__.c \
 	jpegio/JpegDecoder.c \
+	jpegio/MjpegPlayer.c \
 	keypad/__init__.c \
 	keypad/Event.c \
 	keypad/EventQueue.c \
@@ -101,6 +101,9 @@ extern void common_hal_mcu_enable_interrupts(void);
 #define MICROPY_OPT_LOAD_ATTR_FAST_PATH  (CIRCUITPY_OPT_LOAD_ATTR_FAST_PATH)
 #define MICROPY_OPT_MAP_LOOKUP_CACHE  (CIRCUITPY_OPT_MAP_LOOKUP_CACHE)
 #define MICROPY_OPT_MPZ_BITWISE          (0)
+#ifndef MICROPY_OPT_MPZ_DIVIDE_AND_CONQUER
+#define MICROPY_OPT_MPZ_DIVIDE_AND_CONQUER (CIRCUITPY_FULL_BUILD)
+#endif
 #define MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE (CIRCUITPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE)
 #define MICROPY_PERSISTENT_CODE_LOAD     (1)
 
@@ -140,6 +143,9 @@ extern void common_hal_mcu_enable_interrupts(void);
 #define MICROPY_PY_IO_IOBASE             (CIRCUITPY_IO_IOBASE)
 // In extmod
 #define MICROPY_PY_JSON                 (CIRCUITPY_JSON)
+#ifndef MICROPY_PY_JSON_ITERLOAD
+#define MICROPY_PY_JSON_ITERLOAD        (CIRCUITPY_FULL_BUILD)
+#endif
 #define MICROPY_PY_MATH                  (0)
 #define MICROPY_PY_MICROPYTHON_MEM_INFO  (0)
 // Supplanted by shared-bindings/random
@@ -252,6 +258,10 @@ typedef long mp_off_t;
 #define MICROPY_PY_BUILTINS_STR_PARTITION     (CIRCUITPY_FULL_BUILD)
 #define MICROPY_PY_BUILTINS_STR_SPLITLINES    (CIRCUITPY_FULL_BUILD)
 
+#ifndef MICROPY_PY_BUILTINS_LIST_SORT_STABLE
+#define MICROPY_PY_BUILTINS_LIST_SORT_STABLE  (CIRCUITPY_FULL_BUILD)
+#endif
+
 #ifndef MICROPY_PY_COLLECTIONS_ORDEREDDICT
 #define MICROPY_PY_COLLECTIONS_ORDEREDDICT    (CIRCUITPY_FULL_BUILD)
 #endif
@@ -281,6 +291,12 @@ typedef long mp_off_t;
 #define MICROPY_PY_RE_MATCH_GROUPS           (CIRCUITPY_RE)
 #define MICROPY_PY_RE_MATCH_SPAN_START_END   (CIRCUITPY_RE)
 #define MICROPY_PY_RE_SUB                    (CIRCUITPY_RE)
+#ifndef MICROPY_PY_RE_PIKEVM
+#define MICROPY_PY_RE_PIKEVM                 (CIRCUITPY_RE && CIRCUITPY_FULL_BUILD)
+#endif
+#ifndef MICROPY_PY_RE_CACHE_SIZE
+#define MICROPY_PY_RE_CACHE_SIZE             (CIRCUITPY_FULL_BUILD ? 4 : 0)
+#endif
 
 #define CIRCUITPY_MICROPYTHON_ADVANCED        (0)
 
@@ -396,6 +412,18 @@ typedef long mp_off_t;
 #define CIRCUITPY_DISPLAY_AREA_BUFFER_SIZE (512)
 #endif
 
+// Maximum number of rectangles dirty areas are merged into before a refresh.
+#ifndef CIRCUITPY_DISPLAY_DAMAGE_AREAS
+#define CIRCUITPY_DISPLAY_DAMAGE_AREAS (8)
+#endif
+
+// Estimated cost, in pixels, of refreshing an extra rectangle (window setup
+// commands and another pass over the group tree). Dirty areas are merged when
+// their union is cheaper than refreshing them separately.
+#ifndef CIRCUITPY_DISPLAY_AREA_OVERHEAD_PIXELS
+#define CIRCUITPY_DISPLAY_AREA_OVERHEAD_PIXELS (64)
+#endif
+
 #else
 #define CIRCUITPY_DISPLAY_LIMIT (0)
 #define CIRCUITPY_DISPLAY_AREA_BUFFER_SIZE (0)
@@ -462,8 +490,23 @@ extern const struct _mp_obj_module_t nvm_module;
 void background_callback_run_all(void);
 #define RUN_BACKGROUND_TASKS (background_callback_run_all())
 
-#define MICROPY_VM_HOOK_LOOP RUN_BACKGROUND_TASKS;
-#define MICROPY_VM_HOOK_RETURN RUN_BACKGROUND_TASKS;
+// Backwards jumps and returns only run background tasks when a callback has
+// been queued, or after CIRCUITPY_BACKGROUND_VM_HOOK_INTERVAL of them
+// otherwise, so that tight loops don't make a call on every iteration.
+#ifndef CIRCUITPY_BACKGROUND_VM_HOOK_INTERVAL
+#define CIRCUITPY_BACKGROUND_VM_HOOK_INTERVAL (32)
+#endif
+extern volatile uint8_t background_callback_queued;
+extern uint8_t background_callback_vm_hook_countdown;
+#define RUN_BACKGROUND_TASKS_IF_DUE \
+    do { \
+        if (background_callback_queued || --background_callback_vm_hook_countdown == 0) { \
+            RUN_BACKGROUND_TASKS; \
+        } \
+    } while (0)
+
+#define MICROPY_VM_HOOK_LOOP RUN_BACKGROUND_TASKS_IF_DUE;
+#define MICROPY_VM_HOOK_RETURN RUN_BACKGROUND_TASKS_IF_DUE;
 #define MICROPY_INTERNAL_EVENT_HOOK (RUN_BACKGROUND_TASKS)
 
 // CIRCUITPY_AUTORELOAD_DELAY_MS = 0 will completely disable autoreload.
@@ -475,6 +518,37 @@ void background_callback_run_all(void);
 #define CIRCUITPY_FILESYSTEM_FLUSH_INTERVAL_MS 1000
 #endif
 
+// The most erase sectors of external flash to cache in ram while writing. Each
+// one takes about 4kB, allocated only while there is memory for it.
+#ifndef CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS
+#define CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS (CIRCUITPY_FULL_BUILD ? 4 : 1)
+#endif
+
+// Bytes of console output to gather before sending them on. 0 sends each write
+// straight away.
+#ifndef CIRCUITPY_SERIAL_OUTPUT_BUFFER_SIZE
+#define CIRCUITPY_SERIAL_OUTPUT_BUFFER_SIZE (CIRCUITPY_FULL_BUILD ? 256 : 0)
+#endif
+
+// Most bytes of port heap used to cache a directory listing for the web
+// workflow. Larger directories are listed straight from the filesystem.
+#ifndef CIRCUITPY_WEB_WORKFLOW_DIRECTORY_CACHE_SIZE
+#define CIRCUITPY_WEB_WORKFLOW_DIRECTORY_CACHE_SIZE (8192)
+#endif
+
+// Bytes of each file opened with "a" that are gathered in RAM before being
+// written. At least a sector, or 0 to write straight through.
+#ifndef CIRCUITPY_FATFS_APPEND_BUFFER_SIZE
+#define CIRCUITPY_FATFS_APPEND_BUFFER_SIZE (CIRCUITPY_FULL_BUILD ? 512 : 0)
+#endif
+
+// Blocks of USB mass storage reads to read ahead, and writes to gather, before
+// passing them on to the filesystem's block device. Only used when TinyUSB's
+// own buffer is smaller.
+#ifndef CIRCUITPY_USB_MSC_BATCH_BLOCKS
+#define CIRCUITPY_USB_MSC_BATCH_BLOCKS (CIRCUITPY_FULL_BUILD ? 8 : 0)
+#endif
+
 #ifndef CIRCUITPY_PYSTACK_SIZE
 #define CIRCUITPY_PYSTACK_SIZE 2048
 #endif
@@ -88,6 +88,10 @@ MICROPY_ROM_TEXT_COMPRESSION = 0
 MICROPY_PY_ASYNCIO ?= $(MICROPY_PY_ASYNC_AWAIT)
 CFLAGS += -DMICROPY_PY_ASYNCIO=$(MICROPY_PY_ASYNCIO)
 
+# keep near asyncio deadlines in a timer wheel rather than the pairing heap
+MICROPY_PY_ASYNCIO_TIMER_WHEEL ?= $(MICROPY_PY_ASYNCIO)
+CFLAGS += -DMICROPY_PY_ASYNCIO_TIMER_WHEEL=$(MICROPY_PY_ASYNCIO_TIMER_WHEEL)
+
 # asyncio normally needs select
 MICROPY_PY_SELECT ?= $(MICROPY_PY_ASYNCIO)
 CFLAGS += -DMICROPY_PY_SELECT=$(MICROPY_PY_SELECT)
@@ -96,6 +100,14 @@ CFLAGS += -DMICROPY_PY_SELECT=$(MICROPY_PY_SELECT)
 MICROPY_PY_SELECT_SELECT ?= $(MICROPY_PY_SELECT)
 CFLAGS += -DMICROPY_PY_SELECT_SELECT=$(MICROPY_PY_SELECT_SELECT)
 
+# let native streams tell select.poll when they may have become ready
+MICROPY_PY_SELECT_POLL_NOTIFY ?= $(MICROPY_PY_SELECT)
+CFLAGS += -DMICROPY_PY_SELECT_POLL_NOTIFY=$(MICROPY_PY_SELECT_POLL_NOTIFY)
+
+# array.array add, mul, scale, clip, sum and dot methods
+MICROPY_PY_ARRAY_ELEMENTWISE ?= $(CIRCUITPY_FULL_BUILD)
+CFLAGS += -DMICROPY_PY_ARRAY_ELEMENTWISE=$(MICROPY_PY_ARRAY_ELEMENTWISE)
+
 CIRCUITPY_AESIO ?= $(CIRCUITPY_FULL_BUILD)
 CFLAGS += -DCIRCUITPY_AESIO=$(CIRCUITPY_AESIO)
 
@@ -173,6 +185,10 @@ CFLAGS += -DCIRCUITPY_AUDIOFREEVERB=$(CIRCUITPY_AUDIOFREEVERB)
 CIRCUITPY_AURORA_EPAPER ?= 0
 CFLAGS += -DCIRCUITPY_AURORA_EPAPER=$(CIRCUITPY_AURORA_EPAPER)
 
+# Keep run counts and durations of background callbacks, for supervisor.get_background_stats().
+CIRCUITPY_BACKGROUND_CALLBACK_STATS ?= $(CIRCUITPY_FULL_BUILD)
+CFLAGS += -DCIRCUITPY_BACKGROUND_CALLBACK_STATS=$(CIRCUITPY_BACKGROUND_CALLBACK_STATS)
+
 CIRCUITPY_BINASCII ?= $(CIRCUITPY_FULL_BUILD)
 CFLAGS += -DCIRCUITPY_BINASCII=$(CIRCUITPY_BINASCII)
 
@@ -227,6 +243,10 @@ CFLAGS += -DCIRCUITPY_BUSIO_SPI=$(CIRCUITPY_BUSIO_SPI)
 CIRCUITPY_BUSIO_UART ?= $(CIRCUITPY_BUSIO)
 CFLAGS += -DCIRCUITPY_BUSIO_UART=$(CIRCUITPY_BUSIO_UART)
 
+# Set by ports whose UART notifies select.poll when data arrives
+CIRCUITPY_BUSIO_UART_POLL_NOTIFY ?= 0
+CFLAGS += -DCIRCUITPY_BUSIO_UART_POLL_NOTIFY=$(CIRCUITPY_BUSIO_UART_POLL_NOTIFY)
+
 CIRCUITPY_CAMERA ?= 0
 CFLAGS += -DCIRCUITPY_CAMERA=$(CIRCUITPY_CAMERA)
 
@@ -566,6 +586,10 @@ CFLAGS += -DCIRCUITPY_SPITARGET=$(CIRCUITPY_SPITARGET)
 CIRCUITPY_SOCKETPOOL_IPV6 ?= 0
 CFLAGS += -DCIRCUITPY_SOCKETPOOL_IPV6=$(CIRCUITPY_SOCKETPOOL_IPV6)
 
+# Set by ports whose sockets notify select.poll when they may have become ready
+CIRCUITPY_SOCKETPOOL_POLL_NOTIFY ?= 0
+CFLAGS += -DCIRCUITPY_SOCKETPOOL_POLL_NOTIFY=$(CIRCUITPY_SOCKETPOOL_POLL_NOTIFY)
+
 CIRCUITPY_SSL ?= $(CIRCUITPY_WIFI)
 CFLAGS += -DCIRCUITPY_SSL=$(CIRCUITPY_SSL)
 
@@ -708,6 +708,13 @@ typedef uint64_t mp_uint_t;
 #define MICROPY_OPT_MPZ_BITWISE (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
 #endif
 
+// CIRCUITPY-CHANGE
+// Whether to use divide-and-conquer algorithms for large mpz values:
+// Karatsuba multiplication and recursive conversion to a string.
+#ifndef MICROPY_OPT_MPZ_DIVIDE_AND_CONQUER
+#define MICROPY_OPT_MPZ_DIVIDE_AND_CONQUER (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
+#endif
+
 
 // Whether math.factorial is large, fast and recursive (1) or small and slow (0).
 #ifndef MICROPY_OPT_MATH_FACTORIAL
@@ -1404,6 +1411,14 @@ typedef time_t mp_timestamp_t;
 #define MICROPY_PY_BUILTINS_STR_SPLITLINES (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
 #endif
 
+// CIRCUITPY-CHANGE: stable, adaptive list.sort()
+// Whether list.sort() and sorted() use a stable merge sort that calls the key
+// function once per item. It needs scratch memory and falls back to the
+// in-place quicksort when that can't be allocated.
+#ifndef MICROPY_PY_BUILTINS_LIST_SORT_STABLE
+#define MICROPY_PY_BUILTINS_LIST_SORT_STABLE (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
+#endif
+
 // Whether to support bytearray object
 #ifndef MICROPY_PY_BUILTINS_BYTEARRAY
 #define MICROPY_PY_BUILTINS_BYTEARRAY (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_CORE_FEATURES)
@@ -1605,6 +1620,12 @@ typedef time_t mp_timestamp_t;
 #define MICROPY_PY_ARRAY (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_CORE_FEATURES)
 #endif
 
+// CIRCUITPY-CHANGE: Whether array.array has add, mul, scale, clip, sum and dot
+// methods that work on the items in C
+#ifndef MICROPY_PY_ARRAY_ELEMENTWISE
+#define MICROPY_PY_ARRAY_ELEMENTWISE (MICROPY_PY_ARRAY && MICROPY_PY_BUILTINS_FLOAT && MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
+#endif
+
 // Whether to support slice assignments for array (and bytearray).
 // This is rarely used, but adds ~0.5K of code.
 #ifndef MICROPY_PY_ARRAY_SLICE_ASSIGN
@@ -1877,6 +1898,18 @@ typedef time_t mp_timestamp_t;
 #define MICROPY_PY_SELECT_POSIX_OPTIMISATIONS (0)
 #endif
 
+// CIRCUITPY-CHANGE: Whether streams can notify select.poll when they may have
+// become ready, so that poll only calls ioctl on objects with something to report
+#ifndef MICROPY_PY_SELECT_POLL_NOTIFY
+#define MICROPY_PY_SELECT_POLL_NOTIFY (MICROPY_PY_SELECT)
+#endif
+
+// Number of notifications kept for poll objects to catch up on (a power of 2);
+// a poll object that falls further behind re-polls everything registered
+#ifndef MICROPY_PY_SELECT_POLL_NOTIFY_DEPTH
+#define MICROPY_PY_SELECT_POLL_NOTIFY_DEPTH (16)
+#endif
+
 // Whether to enable the select() function in the "select" module (baremetal
 // implementation). This is present for compatibility but can be disabled to
 // save space.
@@ -1941,6 +1974,12 @@ typedef time_t mp_timestamp_t;
 #define MICROPY_PY_ASYNCIO_TASK_QUEUE_PUSH_CALLBACK (0)
 #endif
 
+// CIRCUITPY-CHANGE: Whether a TaskQueue keeps tasks pushed with a near deadline in
+// a hierarchical timer wheel, using the pairing heap only for far or past deadlines
+#ifndef MICROPY_PY_ASYNCIO_TIMER_WHEEL
+#define MICROPY_PY_ASYNCIO_TIMER_WHEEL (MICROPY_PY_ASYNCIO)
+#endif
+
 #ifndef MICROPY_PY_UCTYPES
 #define MICROPY_PY_UCTYPES (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
 #endif
@@ -1976,6 +2015,12 @@ typedef time_t mp_timestamp_t;
 #define MICROPY_PY_JSON_SEPARATORS (1)
 #endif
 
+// CIRCUITPY-CHANGE
+// Whether to provide json.iterload, which yields items of a document one at a time
+#ifndef MICROPY_PY_JSON_ITERLOAD
+#define MICROPY_PY_JSON_ITERLOAD (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
+#endif
+
 #ifndef MICROPY_PY_OS
 #define MICROPY_PY_OS (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
 #endif
@@ -2004,6 +2049,18 @@ typedef time_t mp_timestamp_t;
 #define MICROPY_PY_RE_SUB (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
 #endif
 
+// CIRCUITPY-CHANGE
+// Whether to provide the linear-time Pike VM engine, used for patterns that
+// would backtrack badly or when requested with re.PIKEVM
+#ifndef MICROPY_PY_RE_PIKEVM
+#define MICROPY_PY_RE_PIKEVM (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
+#endif
+
+// Number of compiled patterns the module-level re functions keep for reuse
+#ifndef MICROPY_PY_RE_CACHE_SIZE
+#define MICROPY_PY_RE_CACHE_SIZE (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES ? 4 : 0)
+#endif
+
 #ifndef MICROPY_PY_HEAPQ
 #define MICROPY_PY_HEAPQ (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
 #endif
@@ -461,6 +461,132 @@ static size_t mpn_mul(mpz_dig_t *idig, mpz_dig_t *jdig, size_t jlen, mpz_dig_t *
     return ilen;
 }
 
+// CIRCUITPY-CHANGE
+#if MICROPY_OPT_MPZ_DIVIDE_AND_CONQUER
+
+/* computes i += j
+   i has ilen digits, j has jlen <= ilen digits; neither need be normalised
+   returns the carry out of the top digit of i
+*/
+static mpz_dig_t mpn_add_to(mpz_dig_t *idig, size_t ilen, const mpz_dig_t *jdig, size_t jlen) {
+    mpz_dbl_dig_t carry = 0;
+    size_t n = 0;
+    for (; n < jlen; ++n) {
+        carry += (mpz_dbl_dig_t)idig[n] + (mpz_dbl_dig_t)jdig[n];
+        idig[n] = carry & DIG_MASK;
+        carry >>= DIG_SIZE;
+    }
+    for (; carry != 0 && n < ilen; ++n) {
+        carry += idig[n];
+        idig[n] = carry & DIG_MASK;
+        carry >>= DIG_SIZE;
+    }
+    return carry;
+}
+
+/* computes i -= j
+   i has ilen digits, j has jlen <= ilen digits; neither need be normalised
+   assumes i >= j
+*/
+static void mpn_sub_from(mpz_dig_t *idig, size_t ilen, const mpz_dig_t *jdig, size_t jlen) {
+    mpz_dbl_dig_signed_t borrow = 0;
+    size_t n = 0;
+    for (; n < jlen; ++n) {
+        borrow += (mpz_dbl_dig_t)idig[n] - (mpz_dbl_dig_t)jdig[n];
+        idig[n] = borrow & DIG_MASK;
+        borrow >>= DIG_SIZE; // signed shift
+    }
+    for (; borrow != 0 && n < ilen; ++n) {
+        borrow += idig[n];
+        idig[n] = borrow & DIG_MASK;
+        borrow >>= DIG_SIZE; // signed shift
+    }
+}
+
+/* returns the number of scratch digits that mpn_mul_karatsuba needs */
+static size_t mpn_mul_karatsuba_scratch(size_t jlen, size_t klen) {
+    if (jlen < klen) {
+        size_t t = jlen;
+        jlen = klen;
+        klen = t;
+    }
+    if (klen < MPZ_KARATSUBA_THRESHOLD) {
+        return 0;
+    }
+    size_t m = (jlen + 1) / 2;
+    if (klen <= m) {
+        size_t lo = mpn_mul_karatsuba_scratch(m, klen);
+        size_t hi = jlen - m + klen + mpn_mul_karatsuba_scratch(jlen - m, klen);
+        return lo > hi ? lo : hi;
+    }
+    return 4 * m + 4 + mpn_mul_karatsuba_scratch(m + 1, m + 1);
+}
+
+/* computes i = j * k using Karatsuba's method, writing all jlen + klen digits of i
+   j and k need not be normalised and can point to the same memory
+   tmp must have the number of digits given by mpn_mul_karatsuba_scratch
+*/
+static void mpn_mul_karatsuba(mpz_dig_t *idig, const mpz_dig_t *jdig, size_t jlen, const mpz_dig_t *kdig, size_t klen, mpz_dig_t *tmp) {
+    if (jlen < klen) {
+        const mpz_dig_t *td = jdig;
+        jdig = kdig;
+        kdig = td;
+        size_t t = jlen;
+        jlen = klen;
+        klen = t;
+    }
+    size_t ilen = jlen + klen;
+
+    if (klen < MPZ_KARATSUBA_THRESHOLD) {
+        memset(idig, 0, ilen * sizeof(mpz_dig_t));
+        mpn_mul(idig, (mpz_dig_t *)jdig, jlen, (mpz_dig_t *)kdig, klen);
+        return;
+    }
+
+    size_t m = (jlen + 1) / 2;
+
+    if (klen <= m) {
+        // Unbalanced: i = j_lo * k + (j_hi * k << m)
+        size_t hlen = jlen - m + klen;
+        mpn_mul_karatsuba(idig, jdig, m, kdig, klen, tmp);
+        memset(idig + m + klen, 0, (ilen - m - klen) * sizeof(mpz_dig_t));
+        mpn_mul_karatsuba(tmp, jdig + m, jlen - m, kdig, klen, tmp + hlen);
+        mpn_add_to(idig + m, ilen - m, tmp, hlen);
+        return;
+    }
+
+    // With j = j1 << m + j0 and k = k1 << m + k0:
+    //   i = z2 << 2m + (z1 - z2 - z0) << m + z0
+    // where z0 = j0 * k0, z2 = j1 * k1 and z1 = (j0 + j1) * (k0 + k1).
+    mpn_mul_karatsuba(idig, jdig, m, kdig, m, tmp);
+    mpn_mul_karatsuba(idig + 2 * m, jdig + m, jlen - m, kdig + m, klen - m, tmp);
+
+    mpz_dig_t *sj = tmp;
+    mpz_dig_t *sk = tmp + m + 1;
+    mpz_dig_t *z1 = tmp + 2 * m + 2;
+    memcpy(sj, jdig, m * sizeof(mpz_dig_t));
+    sj[m] = mpn_add_to(sj, m, jdig + m, jlen - m);
+    memcpy(sk, kdig, m * sizeof(mpz_dig_t));
+    sk[m] = mpn_add_to(sk, m, kdig + m, klen - m);
+    mpn_mul_karatsuba(z1, sj, m + 1, sk, m + 1, tmp + 4 * m + 4);
+
+    size_t z1len = 2 * m + 2;
+    mpn_sub_from(z1, z1len, idig, 2 * m);
+    mpn_sub_from(z1, z1len, idig + 2 * m, ilen - 2 * m);
+    // The top digits of z1 are zero when it doesn't overlap the end of i.
+    if (z1len > ilen - m) {
+        z1len = ilen - m;
+    }
+    mpn_add_to(idig + m, ilen - m, z1, z1len);
+
+    // CIRCUITPY-CHANGE: prevent usb and other background task starvation
+    #ifdef RUN_BACKGROUND_TASKS
+    RUN_BACKGROUND_TASKS;
+    #endif
+}
+
+#endif
+
 /* natural_div - quo * den + new_num = old_num (ie num is replaced with rem)
    assumes den != 0
    assumes num_dig has enough memory to be extended by 1 digit
@@ -1310,8 +1436,23 @@ void mpz_mul_inpl(mpz_t *dest, const mpz_t *lhs, const mpz_t *rhs) {
     }
 
     mpz_need_dig(dest, lhs->len + rhs->len); // min mem l+r-1, max mem l+r
-    memset(dest->dig, 0, dest->alloc * sizeof(mpz_dig_t));
-    dest->len = mpn_mul(dest->dig, lhs->dig, lhs->len, rhs->dig, rhs->len);
+    // CIRCUITPY-CHANGE
+    #if MICROPY_OPT_MPZ_DIVIDE_AND_CONQUER
+    if (lhs->len >= MPZ_KARATSUBA_THRESHOLD && rhs->len >= MPZ_KARATSUBA_THRESHOLD) {
+        size_t tmp_len = mpn_mul_karatsuba_scratch(lhs->len, rhs->len);
+        mpz_dig_t *tmp = m_new(mpz_dig_t, tmp_len);
+        mpn_mul_karatsuba(dest->dig, lhs->dig, lhs->len, rhs->dig, rhs->len, tmp);
+        m_del(mpz_dig_t, tmp, tmp_len);
+        dest->len = lhs->len + rhs->len;
+        while (dest->len > 0 && dest->dig[dest->len - 1] == 0) {
+            --dest->len;
+        }
+    } else
+    #endif
+    {
+        memset(dest->dig, 0, dest->alloc * sizeof(mpz_dig_t));
+        dest->len = mpn_mul(dest->dig, lhs->dig, lhs->len, rhs->dig, rhs->len);
+    }
 
     if (lhs->neg == rhs->neg) {
         dest->neg = 0;
@@ -1671,6 +1812,82 @@ char *mpz_as_str(const mpz_t *i, unsigned int base) {
 }
 #endif
 
+// CIRCUITPY-CHANGE
+// Writes the characters of the number in dig (which is destroyed) least
+// significant first, padded with zeros to at least pad characters, and returns
+// the end.  Each pass over the number divides by the largest power of base
+// that fits in a digit, giving several characters for one long division.
+static char *mpn_as_str_rev(mpz_dig_t *dig, size_t ilen, unsigned int base, char base_char, size_t pad, char *s) {
+    mpz_dig_t chunk = base;
+    unsigned int chunk_chars = 1;
+    while ((mpz_dbl_dig_t)chunk * base <= DIG_MASK) {
+        chunk *= base;
+        ++chunk_chars;
+    }
+
+    char *start = s;
+    while (ilen > 0 && dig[ilen - 1] == 0) {
+        --ilen;
+    }
+    while (ilen > 0) {
+        mpz_dbl_dig_t a = 0;
+        for (mpz_dig_t *d = dig + ilen; --d >= dig;) {
+            a = (a << DIG_SIZE) | *d;
+            *d = a / chunk;
+            a %= chunk;
+        }
+        while (ilen > 0 && dig[ilen - 1] == 0) {
+            --ilen;
+        }
+
+        // convert to characters; the most significant chunk has no leading zeros
+        for (unsigned int n = 0; n < chunk_chars && (ilen > 0 || a != 0); ++n) {
+            char c = '0' + a % base;
+            if (c > '9') {
+                c += base_char - '9' - 1;
+            }
+            *s++ = c;
+            a /= base;
+        }
+    }
+    while ((size_t)(s - start) < pad) {
+        *s++ = '0';
+    }
+    return s;
+}
+
+#if MICROPY_OPT_MPZ_DIVIDE_AND_CONQUER
+
+// Converts a non-negative z as mpn_as_str_rev does, but for large numbers
+// splits z in two by dividing by pow[level - 1] = base ** chars, where chars
+// doubles at each level, and converts the halves separately.
+static char *mpz_as_str_rev_dc(const mpz_t *z, const mpz_t *pow, size_t level, size_t chars, unsigned int base, char base_char, size_t pad, char *s) {
+    while (level > 0 && mpz_cmp(z, &pow[level - 1]) < 0) {
+        --level;
+    }
+    if (level == 0 || z->len < MPZ_STR_DC_THRESHOLD) {
+        mpz_dig_t *dig = m_new(mpz_dig_t, z->len);
+        memcpy(dig, z->dig, z->len * sizeof(mpz_dig_t));
+        s = mpn_as_str_rev(dig, z->len, base, base_char, pad, s);
+        m_del(mpz_dig_t, dig, z->len);
+        return s;
+    }
+
+    --level;
+    size_t lo_chars = chars << level;
+    mpz_t quo, rem;
+    mpz_init_zero(&quo);
+    mpz_init_zero(&rem);
+    mpz_divmod_inpl(&quo, &rem, z, &pow[level]);
+    s = mpz_as_str_rev_dc(&rem, pow, level, chars, base, base_char, lo_chars, s);
+    mpz_deinit(&rem);
+    s = mpz_as_str_rev_dc(&quo, pow, level, chars, base, base_char, pad > lo_chars ? pad - lo_chars : 0, s);
+    mpz_deinit(&quo);
+    return s;
+}
+
+#endif
+
 // assumes enough space in str as calculated by mp_int_format_size
 // base must be between 2 and 32 inclusive
 // returns length of string, not including null byte
@@ -1694,48 +1911,55 @@ size_t mpz_as_str_inpl(const mpz_t *i, unsigned int base, const char *prefix, ch
         return s - str;
     }
 
-    // make a copy of mpz digits, so we can do the div/mod calculation
-    mpz_dig_t *dig = m_new(mpz_dig_t, ilen);
-    memcpy(dig, i->dig, ilen * sizeof(mpz_dig_t));
-
-    // convert
-    char *last_comma = str;
-    bool done;
-    do {
-        mpz_dig_t *d = dig + ilen;
-        mpz_dbl_dig_t a = 0;
-
-        // compute next remainder
-        while (--d >= dig) {
-            a = (a << DIG_SIZE) | *d;
-            *d = a / base;
-            a %= base;
+    // CIRCUITPY-CHANGE: convert least significant character first, then add
+    // the commas, prefix and sign and reverse the whole string
+    #if MICROPY_OPT_MPZ_DIVIDE_AND_CONQUER
+    if (ilen >= 2 * MPZ_STR_DC_THRESHOLD) {
+        // pow[n] = base ** (chars << n), up to about half the size of i
+        mpz_t pow[24];
+        size_t chars = 1;
+        mpz_init_from_int(&pow[0], base);
+        while ((mpz_dbl_dig_t)pow[0].dig[0] * base <= DIG_MASK) {
+            pow[0].dig[0] *= base;
+            ++chars;
         }
-
-        // convert to character
-        a += '0';
-        if (a > '9') {
-            a += base_char - '9' - 1;
+        size_t levels = 1;
+        while (2 * pow[levels - 1].len <= ilen && levels < MP_ARRAY_SIZE(pow)) {
+            mpz_init_zero(&pow[levels]);
+            mpz_mul_inpl(&pow[levels], &pow[levels - 1], &pow[levels - 1]);
+            ++levels;
         }
-        *s++ = a;
-
-        // check if number is zero
-        done = true;
-        for (d = dig; d < dig + ilen; ++d) {
-            if (*d != 0) {
-                done = false;
-                break;
-            }
+        mpz_t abs = *i;
+        abs.neg = 0;
+        s = mpz_as_str_rev_dc(&abs, pow, levels, chars, base, base_char, 0, s);
+        while (levels > 0) {
+            mpz_deinit(&pow[--levels]);
         }
-        if (!done && comma && (s - last_comma) == n_comma) {
-            *s++ = comma;
-            last_comma = s;
+    } else
+    #endif
+    {
+        // make a copy of mpz digits, so we can do the div/mod calculation
+        mpz_dig_t *dig = m_new(mpz_dig_t, ilen);
+        memcpy(dig, i->dig, ilen * sizeof(mpz_dig_t));
+        s = mpn_as_str_rev(dig, ilen, base, base_char, 0, s);
+        // free the copy of the digits array
+        m_del(mpz_dig_t, dig, ilen);
+    }
+
+    if (comma) {
+        // spread the characters out to make room for the commas
+        size_t n = s - str;
+        size_t n_commas = (n - 1) / n_comma;
+        char *src = s;
+        s += n_commas;
+        char *dst = s;
+        for (size_t k = n; k > 0; --k) {
+            *--dst = *--src;
+            if ((k - 1) % n_comma == 0 && k > 1) {
+                *--dst = comma;
+            }
         }
     }
-    while (!done);
-
-    // free the copy of the digits array
-    m_del(mpz_dig_t, dig, ilen);
 
     if (prefix) {
         const char *p = &prefix[strlen(prefix)];
@@ -86,6 +86,17 @@ typedef int8_t mpz_dbl_dig_signed_t;
   #define MPZ_LONG_1 1L
 #endif
 
+// CIRCUITPY-CHANGE
+// Operands with at least this many digits are multiplied with Karatsuba's
+// method, and numbers with at least twice this many digits are converted to
+// strings by splitting them in two (if MICROPY_OPT_MPZ_DIVIDE_AND_CONQUER).
+#ifndef MPZ_KARATSUBA_THRESHOLD
+#define MPZ_KARATSUBA_THRESHOLD (32)
+#endif
+#ifndef MPZ_STR_DC_THRESHOLD
+#define MPZ_STR_DC_THRESHOLD (32)
+#endif
+
 // these define the maximum storage needed to hold an int or long long
 #define MPZ_NUM_DIG_FOR_INT ((sizeof(mp_int_t) * 8 + MPZ_DIG_SIZE - 1) / MPZ_DIG_SIZE)
 #define MPZ_NUM_DIG_FOR_LL ((sizeof(long long) * 8 + MPZ_DIG_SIZE - 1) / MPZ_DIG_SIZE)
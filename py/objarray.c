@@ -530,6 +530,193 @@ static mp_obj_t array_extend(mp_obj_t self_in, mp_obj_t arg_in) {
 MP_DEFINE_CONST_FUN_OBJ_2(mp_obj_array_extend_obj, array_extend);
 #endif
 
+// CIRCUITPY-CHANGE: elementwise arithmetic done on the items themselves, so that
+// no float object is made for each element
+#if MICROPY_PY_ARRAY_ELEMENTWISE
+
+// Run body over the items of self, with a and b the items of self and of the
+// operand as item_t *, and x and y the scalar operands as item_t.  These are
+// simple enough loops for the compiler to vectorise.
+#define ARRAY_LOOP(self, T, b_items, x_in, y_in, body) \
+    do { \
+        typedef T item_t; \
+        item_t *a = (item_t *)(self)->items; \
+        const item_t *b = (const item_t *)(b_items); \
+        const item_t x = (item_t)(x_in); \
+        const item_t y = (item_t)(y_in); \
+        (void)b; \
+        (void)x; \
+        (void)y; \
+        for (size_t i = 0, n = (self)->len; i < n; i++) { \
+            body; \
+        } \
+    } while (0)
+
+// Run body over the items of self, which is an 'f' or 'd' array.
+#define ARRAY_FLOAT_LOOP(self, b_items, x_in, y_in, body) \
+    do { \
+        if ((self)->typecode == 'f') { \
+            ARRAY_LOOP(self, float, b_items, x_in, y_in, body); \
+        } else { \
+            ARRAY_LOOP(self, double, b_items, x_in, y_in, body); \
+        } \
+    } while (0)
+
+// Read an item of a numeric array as a float.
+static mp_float_t array_item_float(char typecode, const void *items, size_t i) {
+    switch (typecode) {
+        case 'b':
+            return ((const int8_t *)items)[i];
+        case BYTEARRAY_TYPECODE:
+        case 'B':
+            return ((const uint8_t *)items)[i];
+        case 'h':
+            return ((const short *)items)[i];
+        case 'H':
+            return ((const unsigned short *)items)[i];
+        case 'i':
+            return ((const int *)items)[i];
+        case 'I':
+            return ((const unsigned int *)items)[i];
+        case 'l':
+            return ((const long *)items)[i];
+        case 'L':
+            return ((const unsigned long *)items)[i];
+        case 'q':
+            return ((const long long *)items)[i];
+        case 'Q':
+            return ((const unsigned long long *)items)[i];
+        case 'f':
+            return (mp_float_t)((const float *)items)[i];
+        case 'd':
+            return (mp_float_t)((const double *)items)[i];
+        default:
+            mp_raise_TypeError(MP_ERROR_TEXT("unsupported type for operator"));
+    }
+}
+
+static mp_obj_array_t *array_get_float_self(mp_obj_t self_in) {
+    mp_obj_array_t *self = MP_OBJ_TO_PTR(self_in);
+    if (self->typecode != 'f' && self->typecode != 'd') {
+        mp_raise_TypeError_varg(MP_ERROR_TEXT("%q must be array of type 'f' or 'd'"), MP_QSTR_self);
+    }
+    return self;
+}
+
+static bool array_is_scalar(mp_obj_t obj) {
+    return mp_obj_is_int(obj) || mp_obj_is_float(obj);
+}
+
+// Get the items of an array (or other buffer) operand, which must be as long as self.
+static char array_get_operand(mp_obj_array_t *self, mp_obj_t other_in, const void **items) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(other_in, &bufinfo, MP_BUFFER_READ);
+    size_t len = bufinfo.len / mp_binary_get_size('@', bufinfo.typecode, NULL);
+    mp_arg_validate_length(len, self->len, MP_QSTR_other);
+    *items = bufinfo.buf;
+    return bufinfo.typecode;
+}
+
+static mp_obj_t array_add(mp_obj_t self_in, mp_obj_t other_in) {
+    mp_obj_array_t *self = array_get_float_self(self_in);
+    if (array_is_scalar(other_in)) {
+        mp_float_t k = mp_obj_get_float(other_in);
+        ARRAY_FLOAT_LOOP(self, NULL, k, 0, a[i] += x);
+        return mp_const_none;
+    }
+    const void *items;
+    char typecode = array_get_operand(self, other_in, &items);
+    if (typecode == self->typecode) {
+        ARRAY_FLOAT_LOOP(self, items, 0, 0, a[i] += b[i]);
+    } else {
+        ARRAY_FLOAT_LOOP(self, NULL, 0, 0, a[i] = (item_t)((mp_float_t)a[i] + array_item_float(typecode, items, i)));
+    }
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(array_add_obj, array_add);
+
+static mp_obj_t array_mul(mp_obj_t self_in, mp_obj_t other_in) {
+    mp_obj_array_t *self = array_get_float_self(self_in);
+    if (array_is_scalar(other_in)) {
+        mp_float_t k = mp_obj_get_float(other_in);
+        ARRAY_FLOAT_LOOP(self, NULL, k, 0, a[i] *= x);
+        return mp_const_none;
+    }
+    const void *items;
+    char typecode = array_get_operand(self, other_in, &items);
+    if (typecode == self->typecode) {
+        ARRAY_FLOAT_LOOP(self, items, 0, 0, a[i] *= b[i]);
+    } else {
+        ARRAY_FLOAT_LOOP(self, NULL, 0, 0, a[i] = (item_t)((mp_float_t)a[i] * array_item_float(typecode, items, i)));
+    }
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(array_mul_obj, array_mul);
+
+static mp_obj_t array_scale(size_t n_args, const mp_obj_t *args) {
+    mp_obj_array_t *self = array_get_float_self(args[0]);
+    mp_float_t k = mp_obj_get_float(args[1]);
+    mp_float_t offset = n_args > 2 ? mp_obj_get_float(args[2]) : 0;
+    ARRAY_FLOAT_LOOP(self, NULL, k, offset, a[i] = a[i] * x + y);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(array_scale_obj, 2, 3, array_scale);
+
+static mp_obj_t array_clip(mp_obj_t self_in, mp_obj_t lo_in, mp_obj_t hi_in) {
+    mp_obj_array_t *self = array_get_float_self(self_in);
+    mp_float_t lo = mp_obj_get_float(lo_in);
+    mp_float_t hi = mp_obj_get_float(hi_in);
+    ARRAY_FLOAT_LOOP(self, NULL, lo, hi, a[i] = a[i] < x ? x : (a[i] > y ? y : a[i]));
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_3(array_clip_obj, array_clip);
+
+static mp_obj_t array_sum(mp_obj_t self_in) {
+    mp_obj_array_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_float_t sum = 0;
+    if (self->typecode == 'f' || self->typecode == 'd') {
+        ARRAY_FLOAT_LOOP(self, NULL, 0, 0, sum += (mp_float_t)a[i]);
+    } else {
+        for (size_t i = 0; i < self->len; i++) {
+            sum += array_item_float(self->typecode, self->items, i);
+        }
+    }
+    return mp_obj_new_float(sum);
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(array_sum_obj, array_sum);
+
+static mp_obj_t array_dot(mp_obj_t self_in, mp_obj_t other_in) {
+    mp_obj_array_t *self = MP_OBJ_TO_PTR(self_in);
+    const void *items;
+    char typecode = array_get_operand(self, other_in, &items);
+    mp_float_t sum = 0;
+    if (typecode == self->typecode && (typecode == 'f' || typecode == 'd')) {
+        ARRAY_FLOAT_LOOP(self, items, 0, 0, sum += (mp_float_t)a[i] * (mp_float_t)b[i]);
+    } else {
+        for (size_t i = 0; i < self->len; i++) {
+            sum += array_item_float(self->typecode, self->items, i) * array_item_float(typecode, items, i);
+        }
+    }
+    return mp_obj_new_float(sum);
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(array_dot_obj, array_dot);
+
+static const mp_rom_map_elem_t array_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_append), MP_ROM_PTR(&mp_obj_array_append_obj) },
+    { MP_ROM_QSTR(MP_QSTR_extend), MP_ROM_PTR(&mp_obj_array_extend_obj) },
+    { MP_ROM_QSTR(MP_QSTR_add), MP_ROM_PTR(&array_add_obj) },
+    { MP_ROM_QSTR(MP_QSTR_mul), MP_ROM_PTR(&array_mul_obj) },
+    { MP_ROM_QSTR(MP_QSTR_scale), MP_ROM_PTR(&array_scale_obj) },
+    { MP_ROM_QSTR(MP_QSTR_clip), MP_ROM_PTR(&array_clip_obj) },
+    { MP_ROM_QSTR(MP_QSTR_sum), MP_ROM_PTR(&array_sum_obj) },
+    { MP_ROM_QSTR(MP_QSTR_dot), MP_ROM_PTR(&array_dot_obj) },
+};
+static MP_DEFINE_CONST_DICT(array_locals_dict, array_locals_dict_table);
+#define ARRAY_LOCALS_DICT array_locals_dict
+#else
+#define ARRAY_LOCALS_DICT mp_obj_array_locals_dict
+#endif // MICROPY_PY_ARRAY_ELEMENTWISE
+
 // CIRCUITPY-CHANGE: buffer_finder used below
 #if MICROPY_PY_BUILTINS_BYTEARRAY && MICROPY_CPYTHON_COMPAT
 static mp_obj_t buffer_finder(size_t n_args, const mp_obj_t *args, int direction, bool is_index) {
@@ -799,7 +986,8 @@ MP_DEFINE_CONST_OBJ_TYPE(
     binary_op, array_binary_op,
     subscr, array_subscr,
     buffer, array_get_buffer,
-    locals_dict, &mp_obj_array_locals_dict
+    // CIRCUITPY-CHANGE
+    locals_dict, &ARRAY_LOCALS_DICT
     );
 #endif
 
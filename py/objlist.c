@@ -345,7 +345,412 @@ static void mp_quicksort(mp_obj_t *head, mp_obj_t *tail, mp_obj_t key_fn, mp_obj
     }
 }
 
-// TODO Python defines sort to be stable but ours is not
+#if MICROPY_PY_BUILTINS_LIST_SORT_STABLE
+// CIRCUITPY-CHANGE: stable, adaptive merge sort
+//
+// This is a simplified timsort. Keys are computed once into a scratch array and
+// sorted alongside the values, so the key function is called exactly once per
+// item. Existing ascending and strictly descending runs are found and extended
+// to a minimum length with binary insertion sort, then merged. When one run
+// keeps winning a merge, galloping (exponential search) moves whole blocks at
+// once, which makes mostly-sorted input close to linear. Everything happens on
+// a copy, so the list is left untouched if a comparison raises.
+
+#define SORT_MIN_MERGE (32)
+#define SORT_MIN_GALLOP (7)
+
+typedef struct _mp_sort_t {
+    // [0] holds keys and [1] holds values, or NULL when they are the same.
+    mp_obj_t *items[2];
+    mp_obj_t *tmp[2];
+    bool reverse;
+} mp_sort_t;
+
+static inline bool sort_lt(const mp_sort_t *s, mp_obj_t a, mp_obj_t b) {
+    if (s->reverse) {
+        mp_obj_t t = a;
+        a = b;
+        b = t;
+    }
+    return mp_obj_is_true(mp_binary_op(MP_BINARY_OP_LESS, a, b));
+}
+
+static inline void sort_move1(mp_obj_t *const dst[2], size_t di, mp_obj_t *const src[2], size_t si) {
+    dst[0][di] = src[0][si];
+    if (dst[1] != NULL) {
+        dst[1][di] = src[1][si];
+    }
+}
+
+static void sort_move(mp_obj_t *const dst[2], size_t di, mp_obj_t *const src[2], size_t si, size_t n) {
+    memmove(&dst[0][di], &src[0][si], n * sizeof(mp_obj_t));
+    if (dst[1] != NULL) {
+        memmove(&dst[1][di], &src[1][si], n * sizeof(mp_obj_t));
+    }
+}
+
+// Returns the number of items at the start of a[0:n] that are less than key.
+// The search starts at a[hint] and grows exponentially from there.
+static size_t sort_gallop_left(const mp_sort_t *s, mp_obj_t key, const mp_obj_t *a, size_t n, size_t hint) {
+    mp_int_t lastofs = 0, ofs = 1;
+    if (sort_lt(s, a[hint], key)) {
+        mp_int_t maxofs = n - hint;
+        while (ofs < maxofs && sort_lt(s, a[hint + ofs], key)) {
+            lastofs = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+        if (ofs > maxofs) {
+            ofs = maxofs;
+        }
+        lastofs += hint;
+        ofs += hint;
+    } else {
+        mp_int_t maxofs = hint + 1;
+        while (ofs < maxofs && !sort_lt(s, a[hint - ofs], key)) {
+            lastofs = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+        if (ofs > maxofs) {
+            ofs = maxofs;
+        }
+        mp_int_t k = lastofs;
+        lastofs = hint - ofs;
+        ofs = hint - k;
+    }
+    // Now a[lastofs] < key <= a[ofs], so binary search between them.
+    lastofs++;
+    while (lastofs < ofs) {
+        mp_int_t m = lastofs + ((ofs - lastofs) >> 1);
+        if (sort_lt(s, a[m], key)) {
+            lastofs = m + 1;
+        } else {
+            ofs = m;
+        }
+    }
+    return ofs;
+}
+
+// Returns the number of items at the start of a[0:n] that are less than or
+// equal to key.
+static size_t sort_gallop_right(const mp_sort_t *s, mp_obj_t key, const mp_obj_t *a, size_t n, size_t hint) {
+    mp_int_t lastofs = 0, ofs = 1;
+    if (sort_lt(s, key, a[hint])) {
+        mp_int_t maxofs = hint + 1;
+        while (ofs < maxofs && sort_lt(s, key, a[hint - ofs])) {
+            lastofs = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+        if (ofs > maxofs) {
+            ofs = maxofs;
+        }
+        mp_int_t k = lastofs;
+        lastofs = hint - ofs;
+        ofs = hint - k;
+    } else {
+        mp_int_t maxofs = n - hint;
+        while (ofs < maxofs && !sort_lt(s, key, a[hint + ofs])) {
+            lastofs = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+        if (ofs > maxofs) {
+            ofs = maxofs;
+        }
+        lastofs += hint;
+        ofs += hint;
+    }
+    // Now a[lastofs] <= key < a[ofs], so binary search between them.
+    lastofs++;
+    while (lastofs < ofs) {
+        mp_int_t m = lastofs + ((ofs - lastofs) >> 1);
+        if (sort_lt(s, key, a[m])) {
+            ofs = m;
+        } else {
+            lastofs = m + 1;
+        }
+    }
+    return ofs;
+}
+
+// Sorts items[lo:hi], of which items[lo:start] are already sorted.
+static void sort_binary_insertion(mp_sort_t *s, size_t lo, size_t hi, size_t start) {
+    mp_obj_t *keys = s->items[0];
+    for (; start < hi; start++) {
+        mp_obj_t pivot = keys[start];
+        size_t l = lo, r = start;
+        while (l < r) {
+            size_t m = l + ((r - l) >> 1);
+            if (sort_lt(s, pivot, keys[m])) {
+                r = m;
+            } else {
+                l = m + 1;
+            }
+        }
+        if (l < start) {
+            sort_move1(s->tmp, 0, s->items, start);
+            sort_move(s->items, l + 1, s->items, l, start - l);
+            sort_move1(s->items, l, s->tmp, 0);
+        }
+    }
+}
+
+// Returns the length of the run starting at items[lo], reversing it in place
+// if it is strictly descending (which keeps the sort stable).
+static size_t sort_count_run(mp_sort_t *s, size_t lo, size_t hi) {
+    mp_obj_t *keys = s->items[0];
+    size_t n = lo + 1;
+    if (n == hi) {
+        return 1;
+    }
+    if (sort_lt(s, keys[n], keys[lo])) {
+        do {
+            n++;
+        } while (n < hi && sort_lt(s, keys[n], keys[n - 1]));
+        for (size_t i = lo, j = n - 1; i < j; i++, j--) {
+            sort_move1(s->tmp, 0, s->items, i);
+            sort_move1(s->items, i, s->items, j);
+            sort_move1(s->items, j, s->tmp, 0);
+        }
+    } else {
+        do {
+            n++;
+        } while (n < hi && !sort_lt(s, keys[n], keys[n - 1]));
+    }
+    return n - lo;
+}
+
+// Merges items[a:a+na] with items[b:b+nb] where na <= nb and b == a + na,
+// working forwards with the first run in the scratch buffer. items[b] must
+// belong before items[a] and items[a+na-1] after all of the second run.
+static void sort_merge_lo(mp_sort_t *s, size_t a, size_t na, size_t b, size_t nb) {
+    mp_obj_t *keys = s->items[0];
+    mp_obj_t *tmpkeys = s->tmp[0];
+    sort_move(s->tmp, 0, s->items, a, na);
+    size_t dest = a, pa = 0, pb = b;
+
+    sort_move1(s->items, dest++, s->items, pb++);
+    if (--nb == 0) {
+        goto done;
+    }
+    if (na == 1) {
+        goto copy_b;
+    }
+    for (;;) {
+        size_t acount = 0, bcount = 0;
+        // One item at a time until a run keeps winning.
+        do {
+            if (sort_lt(s, keys[pb], tmpkeys[pa])) {
+                sort_move1(s->items, dest++, s->items, pb++);
+                bcount++;
+                acount = 0;
+                if (--nb == 0) {
+                    goto done;
+                }
+            } else {
+                sort_move1(s->items, dest++, s->tmp, pa++);
+                acount++;
+                bcount = 0;
+                if (--na == 1) {
+                    goto copy_b;
+                }
+            }
+        } while ((acount | bcount) < SORT_MIN_GALLOP);
+
+        // Gallop until neither run is winning by much.
+        do {
+            acount = sort_gallop_right(s, keys[pb], tmpkeys + pa, na, 0);
+            if (acount) {
+                sort_move(s->items, dest, s->tmp, pa, acount);
+                dest += acount;
+                pa += acount;
+                na -= acount;
+                if (na == 1) {
+                    goto copy_b;
+                }
+                if (na == 0) {
+                    // Only possible with an inconsistent comparison.
+                    goto done;
+                }
+            }
+            sort_move1(s->items, dest++, s->items, pb++);
+            if (--nb == 0) {
+                goto done;
+            }
+
+            bcount = sort_gallop_left(s, tmpkeys[pa], keys + pb, nb, 0);
+            if (bcount) {
+                sort_move(s->items, dest, s->items, pb, bcount);
+                dest += bcount;
+                pb += bcount;
+                nb -= bcount;
+                if (nb == 0) {
+                    goto done;
+                }
+            }
+            sort_move1(s->items, dest++, s->tmp, pa++);
+            if (--na == 1) {
+                goto copy_b;
+            }
+        } while (acount >= SORT_MIN_GALLOP || bcount >= SORT_MIN_GALLOP);
+    }
+
+copy_b:
+    // The last item of the first run belongs after the rest of the second.
+    sort_move(s->items, dest, s->items, pb, nb);
+    sort_move1(s->items, dest + nb, s->tmp, pa);
+    return;
+done:
+    sort_move(s->items, dest, s->tmp, pa, na);
+}
+
+// Like sort_merge_lo but for na > nb, working backwards with the second run in
+// the scratch buffer.
+static void sort_merge_hi(mp_sort_t *s, size_t a, size_t na, size_t b, size_t nb) {
+    mp_obj_t *keys = s->items[0];
+    mp_obj_t *tmpkeys = s->tmp[0];
+    sort_move(s->tmp, 0, s->items, b, nb);
+    // Indices are one past the next item to take so they never go below zero.
+    size_t dest = b + nb, pa = a + na, pb = nb;
+
+    sort_move1(s->items, --dest, s->items, --pa);
+    if (--na == 0) {
+        goto done;
+    }
+    if (nb == 1) {
+        goto copy_a;
+    }
+    for (;;) {
+        size_t acount = 0, bcount = 0;
+        do {
+            if (sort_lt(s, tmpkeys[pb - 1], keys[pa - 1])) {
+                sort_move1(s->items, --dest, s->items, --pa);
+                acount++;
+                bcount = 0;
+                if (--na == 0) {
+                    goto done;
+                }
+            } else {
+                sort_move1(s->items, --dest, s->tmp, --pb);
+                bcount++;
+                acount = 0;
+                if (--nb == 1) {
+                    goto copy_a;
+                }
+            }
+        } while ((acount | bcount) < SORT_MIN_GALLOP);
+
+        do {
+            acount = na - sort_gallop_right(s, tmpkeys[pb - 1], keys + a, na, na - 1);
+            if (acount) {
+                dest -= acount;
+                pa -= acount;
+                sort_move(s->items, dest, s->items, pa, acount);
+                na -= acount;
+                if (na == 0) {
+                    goto done;
+                }
+            }
+            sort_move1(s->items, --dest, s->tmp, --pb);
+            if (--nb == 1) {
+                goto copy_a;
+            }
+
+            bcount = nb - sort_gallop_left(s, keys[pa - 1], tmpkeys, nb, nb - 1);
+            if (bcount) {
+                dest -= bcount;
+                pb -= bcount;
+                sort_move(s->items, dest, s->tmp, pb, bcount);
+                nb -= bcount;
+                if (nb == 1) {
+                    goto copy_a;
+                }
+                if (nb == 0) {
+                    // Only possible with an inconsistent comparison.
+                    goto done;
+                }
+            }
+            sort_move1(s->items, --dest, s->items, --pa);
+            if (--na == 0) {
+                goto done;
+            }
+        } while (acount >= SORT_MIN_GALLOP || bcount >= SORT_MIN_GALLOP);
+    }
+
+copy_a:
+    // The first item of the second run belongs before the rest of the first.
+    dest -= na;
+    pa -= na;
+    sort_move(s->items, dest, s->items, pa, na);
+    sort_move1(s->items, dest - 1, s->tmp, 0);
+    return;
+done:
+    sort_move(s->items, dest - nb, s->tmp, 0, nb);
+}
+
+// Merges the adjacent runs items[a:a+na] and items[a+na:a+na+nb].
+static void sort_merge(mp_sort_t *s, size_t a, size_t na, size_t nb) {
+    mp_obj_t *keys = s->items[0];
+    size_t b = a + na;
+    // Items of the first run that are not greater than the first item of the
+    // second are already in place, as are items of the second run that are
+    // not less than the last item of the first.
+    size_t k = sort_gallop_right(s, keys[b], keys + a, na, 0);
+    a += k;
+    na -= k;
+    if (na == 0) {
+        return;
+    }
+    nb = sort_gallop_left(s, keys[b - 1], keys + b, nb, nb - 1);
+    if (nb == 0) {
+        return;
+    }
+    if (na <= nb) {
+        sort_merge_lo(s, a, na, b, nb);
+    } else {
+        sort_merge_hi(s, a, na, b, nb);
+    }
+}
+
+// Sorts the n items in s->items. The scratch buffer must hold n / 2 + 1 items.
+static void mp_mergesort(mp_sort_t *s, size_t n) {
+    // Pick a minimum run length so that n / minrun is a power of two or a bit less.
+    size_t minrun = n, r = 0;
+    while (minrun >= SORT_MIN_MERGE) {
+        r |= minrun & 1;
+        minrun >>= 1;
+    }
+    minrun += r;
+
+    // Pending runs. Each is more than twice as long as the next, which bounds
+    // the stack by the number of bits in n and keeps merges balanced.
+    struct {
+        size_t base;
+        size_t len;
+    } runs[sizeof(size_t) * 8];
+    size_t num_runs = 0;
+
+    for (size_t lo = 0; lo < n;) {
+        size_t len = sort_count_run(s, lo, n);
+        if (len < minrun) {
+            size_t forced = MIN(minrun, n - lo);
+            sort_binary_insertion(s, lo, lo + forced, lo + len);
+            len = forced;
+        }
+        runs[num_runs].base = lo;
+        runs[num_runs].len = len;
+        num_runs++;
+        lo += len;
+
+        while (num_runs > 1 && (lo == n || runs[num_runs - 2].len <= 2 * runs[num_runs - 1].len)) {
+            sort_merge(s, runs[num_runs - 2].base, runs[num_runs - 2].len, runs[num_runs - 1].len);
+            runs[num_runs - 2].len += runs[num_runs - 1].len;
+            num_runs--;
+        }
+    }
+}
+#endif
+
+// The quicksort is not stable as Python requires, so it is only used when the
+// merge sort is disabled or can't get scratch memory.
 mp_obj_t mp_obj_list_sort(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_key, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE} },
@@ -364,8 +769,40 @@ mp_obj_t mp_obj_list_sort(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_
     mp_obj_list_t *self = native_list(pos_args[0]);
 
     if (self->len > 1) {
-        mp_quicksort(self->items - 1, self->items + self->len - 1,
-            args.key.u_obj == mp_const_none ? MP_OBJ_NULL : args.key.u_obj,
+        mp_obj_t key_fn = args.key.u_obj == mp_const_none ? MP_OBJ_NULL : args.key.u_obj;
+        #if MICROPY_PY_BUILTINS_LIST_SORT_STABLE
+        // CIRCUITPY-CHANGE: sort a copy (plus keys) with the stable merge sort
+        size_t n = self->len;
+        size_t tmp_len = n / 2 + 1;
+        size_t scratch_len = (key_fn == MP_OBJ_NULL ? 1 : 2) * (n + tmp_len);
+        mp_obj_t *scratch = m_new_maybe(mp_obj_t, scratch_len);
+        if (scratch != NULL) {
+            mp_sort_t sort = {
+                .items = { scratch, NULL },
+                .tmp = { scratch + n, NULL },
+                .reverse = args.reverse.u_bool,
+            };
+            mp_obj_t *values = scratch;
+            memcpy(values, self->items, n * sizeof(mp_obj_t));
+            if (key_fn != MP_OBJ_NULL) {
+                values = scratch + n + tmp_len;
+                memcpy(values, self->items, n * sizeof(mp_obj_t));
+                sort.items[1] = values;
+                sort.tmp[1] = values + n;
+                for (size_t i = 0; i < n; i++) {
+                    scratch[i] = mp_call_function_1(key_fn, values[i]);
+                }
+            }
+            mp_mergesort(&sort, n);
+            // If the key function or a comparison resized the list, leave it as they did.
+            if (self->len == n) {
+                memcpy(self->items, values, n * sizeof(mp_obj_t));
+            }
+            m_del(mp_obj_t, scratch, scratch_len);
+            return mp_const_none;
+        }
+        #endif
+        mp_quicksort(self->items - 1, self->items + self->len - 1, key_fn,
             args.reverse.u_bool ? mp_const_false : mp_const_true);
     }
 
@@ -2249,7 +2249,8 @@ mp_obj_t mp_obj_new_str_copy(const mp_obj_type_t *type, const byte *data, size_t
     mp_obj_str_t *o = mp_obj_malloc(mp_obj_str_t, type);
     o->len = len;
     if (data) {
-        o->hash = qstr_compute_hash(data, len);
+        // CIRCUITPY-CHANGE: computed when first needed
+        o->hash = 0;
         byte *p = m_new(byte, len + 1);
         o->data = p;
         memcpy(p, data, len * sizeof(byte));
@@ -2283,7 +2284,8 @@ mp_obj_t mp_obj_new_str_via_qstr(const char *data, size_t len) {
 // is cleared and can safely be passed to vstr_free if it was heap allocated.
 static mp_obj_t mp_obj_new_str_type_from_vstr(const mp_obj_type_t *type, vstr_t *vstr) {
     // if not a bytes object, look if a qstr with this data already exists
-    if (type == &mp_type_str) {
+    // CIRCUITPY-CHANGE: a string too long to be a qstr can't be interned
+    if (type == &mp_type_str && vstr->len < (1 << (8 * MICROPY_QSTR_BYTES_IN_LEN))) {
         qstr q = qstr_find_strn(vstr->buf, vstr->len);
         if (q != MP_QSTRnull) {
             vstr_clear(vstr);
@@ -2308,7 +2310,9 @@ static mp_obj_t mp_obj_new_str_type_from_vstr(const mp_obj_type_t *type, vstr_t
     #endif
     mp_obj_str_t *o = mp_obj_malloc(mp_obj_str_t, type);
     o->len = vstr->len;
-    o->hash = qstr_compute_hash(data, vstr->len);
+    // CIRCUITPY-CHANGE: most strings built at runtime are never hashed, so
+    // leave the hash to be computed (and kept) when first needed
+    o->hash = 0;
     o->data = data;
     return MP_OBJ_FROM_PTR(o);
 }
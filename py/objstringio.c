@@ -110,7 +110,10 @@ static mp_uint_t stringio_write(mp_obj_t o_in, const void *buf, mp_uint_t size,
         // Take all what's already allocated...
         o->vstr->len = o->vstr->alloc;
         // ... and add more
-        vstr_add_len(o->vstr, new_pos - o->vstr->alloc);
+        // CIRCUITPY-CHANGE: at least half as much again, so that building up a
+        // string with many small writes doesn't reallocate on each one
+        vstr_add_len(o->vstr, MAX(new_pos - o->vstr->alloc, o->vstr->alloc / 2));
+        o->vstr->len = org_len;
     }
     // If there was a seek past EOF, clear the hole
     if (o->pos > org_len) {
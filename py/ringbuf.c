@@ -7,14 +7,38 @@
 // SPDX-License-Identifier: MIT
 
 // CIRCUITPY-CHANGE: API and implementation thoroughly reworked
-// No attempt to have atomic operations. Add guards if atomicity required.
+// Lock-free for a single producer and a single consumer. Add guards if there
+// are more.
+
+#include <string.h>
 
 #include "ringbuf.h"
 
+// The side that owns a position reads it plainly. The other side's position
+// is loaded with acquire ordering, so the bytes it covers are seen, and a
+// position is stored with release ordering after the bytes it covers.
+#define LOAD_OTHER(pos) __atomic_load_n(&(pos), __ATOMIC_ACQUIRE)
+#define PUBLISH(pos, value) __atomic_store_n(&(pos), (value), __ATOMIC_RELEASE)
+
+static inline uint32_t advance(ringbuf_t *r, uint32_t pos, size_t n) {
+    pos += n;
+    if (pos >= 2 * r->size) {
+        pos -= 2 * r->size;
+    }
+    return pos;
+}
+
+static inline uint32_t offset(ringbuf_t *r, uint32_t pos) {
+    return pos < r->size ? pos : pos - r->size;
+}
+
+static inline size_t filled(ringbuf_t *r, uint32_t next_read, uint32_t next_write) {
+    return next_write >= next_read ? next_write - next_read : 2 * r->size - next_read + next_write;
+}
+
 bool ringbuf_init(ringbuf_t *r, uint8_t *buf, size_t size) {
     r->buf = buf;
     r->size = size;
-    r->used = 0;
     r->next_read = 0;
     r->next_write = 0;
     return r->buf != NULL;
@@ -29,9 +53,7 @@ bool ringbuf_alloc(ringbuf_t *r, size_t size) {
 void ringbuf_deinit(ringbuf_t *r) {
     // Free buf by doing nothing and letting gc take care of it. If the VM has finished already,
     // this will be safe.
-    r->buf = (uint8_t *)NULL;
-    r->size = 0;
-    ringbuf_clear(r);
+    ringbuf_init(r, NULL, 0);
 }
 
 size_t ringbuf_size(ringbuf_t *r) {
@@ -40,87 +62,115 @@ size_t ringbuf_size(ringbuf_t *r) {
 
 // Return -1 if buffer is empty, else return byte fetched.
 int ringbuf_get(ringbuf_t *r) {
-    if (r->used < 1) {
+    uint32_t next_read = r->next_read;
+    if (next_read == LOAD_OTHER(r->next_write)) {
         return -1;
     }
-    uint8_t v = r->buf[r->next_read];
-    r->next_read++;
-    if (r->next_read >= r->size) {
-        r->next_read = 0;
-    }
-    r->used--;
+    uint8_t v = r->buf[offset(r, next_read)];
+    PUBLISH(r->next_read, advance(r, next_read, 1));
     return v;
 }
 
 int ringbuf_get16(ringbuf_t *r) {
-    if (r->used < 2) {
+    uint8_t v[2];
+    if (ringbuf_num_filled(r) < 2) {
         return -1;
     }
-    int high_byte = ringbuf_get(r);
-    int low_byte = ringbuf_get(r);
-    return (high_byte << 8) | low_byte;
+    ringbuf_get_n(r, v, 2);
+    return (v[0] << 8) | v[1];
 }
 
 // Return -1 if no room in buffer, else return 0.
 int ringbuf_put(ringbuf_t *r, uint8_t v) {
-    if (r->used >= r->size) {
+    uint32_t next_write = r->next_write;
+    if (filled(r, LOAD_OTHER(r->next_read), next_write) >= r->size) {
         return -1;
     }
-    r->buf[r->next_write] = v;
-    r->next_write++;
-    if (r->next_write >= r->size) {
-        r->next_write = 0;
-    }
-    r->used++;
+    r->buf[offset(r, next_write)] = v;
+    PUBLISH(r->next_write, advance(r, next_write, 1));
     return 0;
 }
 
 int ringbuf_put16(ringbuf_t *r, uint16_t v) {
-    if (r->size - r->used < 2) {
+    if (ringbuf_num_empty(r) < 2) {
         return -1;
     }
-    ringbuf_put(r, (v >> 8) & 0xff);
-    ringbuf_put(r, v & 0xff);
+    uint8_t bytes[2] = { (v >> 8) & 0xff, v & 0xff };
+    ringbuf_put_n(r, bytes, 2);
     return 0;
 }
 
 void ringbuf_clear(ringbuf_t *r) {
-    r->next_write = 0;
-    r->next_read = 0;
-    r->used = 0;
+    PUBLISH(r->next_read, LOAD_OTHER(r->next_write));
+}
+
+void ringbuf_drop_pending(ringbuf_t *r) {
+    PUBLISH(r->next_write, LOAD_OTHER(r->next_read));
 }
 
 // Number of free slots that can be written.
 size_t ringbuf_num_empty(ringbuf_t *r) {
-    return r->size - r->used;
+    return r->size - ringbuf_num_filled(r);
 }
 
 // Number of bytes available to read.
 size_t ringbuf_num_filled(ringbuf_t *r) {
-    return r->used;
+    uint32_t next_read = LOAD_OTHER(r->next_read);
+    return filled(r, next_read, LOAD_OTHER(r->next_write));
 }
 
 // If the ring buffer fills up, not all bytes will be written.
 // Returns how many bytes were successfully written.
 size_t ringbuf_put_n(ringbuf_t *r, const uint8_t *buf, size_t bufsize) {
-    for (size_t i = 0; i < bufsize; i++) {
-        if (ringbuf_put(r, buf[i]) < 0) {
-            // If ringbuf is full, give up and return how many bytes
-            // we wrote so far.
-            return i;
+    size_t written = 0;
+    // At most two pieces: up to the end of the buffer, then from the start.
+    while (written < bufsize) {
+        uint8_t *data;
+        size_t n = MIN(ringbuf_reserve_contiguous(r, &data), bufsize - written);
+        if (n == 0) {
+            break;
         }
+        memcpy(data, buf + written, n);
+        ringbuf_commit(r, n);
+        written += n;
     }
-    return bufsize;
+    return written;
 }
 
 // Returns how many bytes were fetched.
 size_t ringbuf_get_n(ringbuf_t *r, uint8_t *buf, size_t bufsize) {
-    for (size_t i = 0; i < bufsize; i++) {
-        int b = ringbuf_get(r);
-        if (b < 0) {
-            return i;
+    size_t read = 0;
+    while (read < bufsize) {
+        const uint8_t *data;
+        size_t n = MIN(ringbuf_peek_contiguous(r, &data), bufsize - read);
+        if (n == 0) {
+            break;
         }
-        buf[i] = b;
+        memcpy(buf + read, data, n);
+        ringbuf_skip(r, n);
+        read += n;
     }
-    return bufsize;
+    return read;
+}
+
+size_t ringbuf_peek_contiguous(ringbuf_t *r, const uint8_t **data) {
+    uint32_t next_read = r->next_read;
+    uint32_t start = offset(r, next_read);
+    *data = r->buf + start;
+    return MIN(filled(r, next_read, LOAD_OTHER(r->next_write)), r->size - start);
+}
+
+void ringbuf_skip(ringbuf_t *r, size_t n) {
+    PUBLISH(r->next_read, advance(r, r->next_read, n));
+}
+
+size_t ringbuf_reserve_contiguous(ringbuf_t *r, uint8_t **data) {
+    uint32_t next_write = r->next_write;
+    uint32_t start = offset(r, next_write);
+    *data = r->buf + start;
+    return MIN(r->size - filled(r, LOAD_OTHER(r->next_read), next_write), r->size - start);
+}
+
+void ringbuf_commit(ringbuf_t *r, size_t n) {
+    PUBLISH(r->next_write, advance(r, r->next_write, n));
 }
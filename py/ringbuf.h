@@ -14,12 +14,15 @@
 
 // CIRCUITPY-CHANGE: API and implementation thoroughly reworked
 
+// Safe without locking for one producer and one consumer, e.g. an interrupt
+// handler and the main loop. Only the producer changes next_write and only the
+// consumer changes next_read. Both count from 0 to 2 * size - 1 so that a full
+// buffer can be told apart from an empty one.
 typedef struct _ringbuf_t {
     uint8_t *buf;
     uint32_t size;
-    uint32_t used;
-    uint32_t next_read;
-    uint32_t next_write;
+    volatile uint32_t next_read;
+    volatile uint32_t next_write;
 } ringbuf_t;
 
 // For static initialization with an existing buffer, use ringbuf_init().
@@ -31,16 +34,32 @@ bool ringbuf_alloc(ringbuf_t *r, size_t capacity);
 // Mark ringbuf as no longer in use, and allow any heap storage to be freed by gc.
 void ringbuf_deinit(ringbuf_t *r);
 
-// Note: Ringbuf operations are not atomic.
+// Note: Each ringbuf operation is either a producer (put) or a consumer (get)
+// operation. Guard them if there is more than one producer or consumer.
 size_t ringbuf_size(ringbuf_t *r);
 int ringbuf_get(ringbuf_t *r);
 int ringbuf_put(ringbuf_t *r, uint8_t v);
+// Consumer operation: drops everything that has been put so far.
 void ringbuf_clear(ringbuf_t *r);
+// Producer operation: drops everything that has been put but not yet gotten,
+// e.g. on ctrl-C. It moves next_write back to the consumer's position, so it
+// must not run while the consumer is partway through a get.
+void ringbuf_drop_pending(ringbuf_t *r);
 size_t ringbuf_num_empty(ringbuf_t *r);
 size_t ringbuf_num_filled(ringbuf_t *r);
 size_t ringbuf_put_n(ringbuf_t *r, const uint8_t *buf, size_t bufsize);
 size_t ringbuf_get_n(ringbuf_t *r, uint8_t *buf, size_t bufsize);
 
+// Zero-copy access. ringbuf_peek_contiguous() sets *data to the next bytes to
+// get and returns how many can be read there without wrapping around.
+// ringbuf_skip() then drops bytes once they have been used.
+size_t ringbuf_peek_contiguous(ringbuf_t *r, const uint8_t **data);
+void ringbuf_skip(ringbuf_t *r, size_t n);
+// The same for the producer: fill in up to the returned number of bytes at
+// *data, e.g. by DMA, and then make them available with ringbuf_commit().
+size_t ringbuf_reserve_contiguous(ringbuf_t *r, uint8_t **data);
+void ringbuf_commit(ringbuf_t *r, size_t n);
+
 // Note: big-endian. Return -1 if can't read or write two bytes.
 int ringbuf_get16(ringbuf_t *r);
 int ringbuf_put16(ringbuf_t *r, uint16_t v);
@@ -187,6 +187,11 @@ void mp_init(void) {
     MP_STATE_VM(bluetooth) = MP_OBJ_NULL;
     #endif
 
+    // CIRCUITPY-CHANGE
+    #if MICROPY_PY_RE && MICROPY_PY_RE_CACHE_SIZE > 0
+    memset(MP_STATE_VM(re_cache), 0, sizeof(MP_STATE_VM(re_cache)));
+    #endif
+
     #if MICROPY_HW_ENABLE_USB_RUNTIME_DEVICE
     MP_STATE_VM(usbd) = MP_OBJ_NULL;
     #endif
@@ -349,6 +354,13 @@ mp_obj_t mp_unary_op(mp_unary_op_t op, mp_obj_t arg) {
         if (h == 0) {
             GET_STR_DATA_LEN(arg, data, len);
             h = qstr_compute_hash(data, len);
+            // CIRCUITPY-CHANGE: keep the hash of a str/bytes made at runtime; one
+            // defined statically with a zero hash may be in read-only memory
+            #if MICROPY_ENABLE_GC
+            if (gc_nbytes(MP_OBJ_TO_PTR(arg)) != 0) {
+                ((mp_obj_str_t *)MP_OBJ_TO_PTR(arg))->hash = h;
+            }
+            #endif
         }
         return MP_OBJ_NEW_SMALL_INT(h);
     } else {
@@ -31,6 +31,8 @@
 #include "py/objstr.h"
 #include "py/stream.h"
 #include "py/runtime.h"
+// CIRCUITPY-CHANGE: for MICROPY_BEGIN_ATOMIC_SECTION
+#include "py/mphal.h"
 
 // This file defines generic Python stream read/write methods which
 // dispatch to the underlying stream interface of an object.
@@ -298,12 +300,15 @@ MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_stream_write1_obj, 2, 4, stream_write1_me
 static mp_obj_t stream_readinto(size_t n_args, const mp_obj_t *args) {
     return stream_readinto_write_generic(n_args, args, MP_STREAM_RW_READ);
 }
-MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_stream_readinto_obj, 2, 3, stream_readinto);
+// CIRCUITPY-CHANGE: also accept (buf, off, max_len) like write, so part of a buffer
+// can be filled without allocating a memoryview slice
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_stream_readinto_obj, 2, 4, stream_readinto);
 
 static mp_obj_t stream_readinto1(size_t n_args, const mp_obj_t *args) {
     return stream_readinto_write_generic(n_args, args, MP_STREAM_RW_READ | MP_STREAM_RW_ONCE);
 }
-MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_stream_readinto1_obj, 2, 3, stream_readinto1);
+// CIRCUITPY-CHANGE
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_stream_readinto1_obj, 2, 4, stream_readinto1);
 
 static mp_obj_t stream_readall(mp_obj_t self_in) {
     const mp_stream_p_t *stream_p = mp_get_stream(self_in);
@@ -336,8 +341,10 @@ static mp_obj_t stream_readall(mp_obj_t self_in) {
             current_read -= out_sz;
             p += out_sz;
         } else {
-            p = vstr_extend(&vstr, DEFAULT_BUFFER_SIZE);
-            current_read = DEFAULT_BUFFER_SIZE;
+            // CIRCUITPY-CHANGE: grow by half the buffer so a long stream is
+            // not copied on every DEFAULT_BUFFER_SIZE bytes read
+            current_read = MAX(DEFAULT_BUFFER_SIZE, vstr.alloc / 2);
+            p = vstr_extend(&vstr, current_read);
         }
     }
 
@@ -433,6 +440,10 @@ mp_obj_t mp_stream_close(mp_obj_t stream) {
     const mp_stream_p_t *stream_p = mp_get_stream(stream);
     int error;
     mp_uint_t res = stream_p->ioctl(stream, MP_STREAM_CLOSE, 0, &error);
+    // CIRCUITPY-CHANGE: let select.poll see that a waiting stream was closed
+    if (stream_p->poll_notify != 0) {
+        mp_stream_poll_notify(stream);
+    }
     if (res == MP_STREAM_ERROR) {
         mp_raise_OSError(error);
     }
@@ -512,6 +523,53 @@ static mp_obj_t stream_ioctl(size_t n_args, const mp_obj_t *args) {
 }
 MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_stream_ioctl_obj, 2, 3, stream_ioctl);
 
+// CIRCUITPY-CHANGE: readiness notification for select.poll
+#if MICROPY_PY_SELECT_POLL_NOTIFY
+
+#if MICROPY_PY_SELECT_POLL_NOTIFY_DEPTH & (MICROPY_PY_SELECT_POLL_NOTIFY_DEPTH - 1)
+#error "MICROPY_PY_SELECT_POLL_NOTIFY_DEPTH must be a power of 2"
+#endif
+
+// The most recently notified streams, indexed by sequence number.  The entries
+// are only compared against registered objects, never dereferenced, so they
+// don't need to be seen by the GC.
+static mp_obj_t stream_poll_notified[MICROPY_PY_SELECT_POLL_NOTIFY_DEPTH];
+static volatile mp_uint_t stream_poll_notify_seq;
+
+void mp_stream_poll_notify(mp_obj_t stream) {
+    mp_uint_t atomic_state = MICROPY_BEGIN_ATOMIC_SECTION();
+    mp_uint_t seq = stream_poll_notify_seq;
+    stream_poll_notified[seq & (MICROPY_PY_SELECT_POLL_NOTIFY_DEPTH - 1)] = stream;
+    stream_poll_notify_seq = seq + 1;
+    MICROPY_END_ATOMIC_SECTION(atomic_state);
+}
+
+mp_uint_t mp_stream_poll_notify_seq(void) {
+    return stream_poll_notify_seq;
+}
+
+// Return the next stream notified since *seq and advance *seq past it.  Returns
+// MP_OBJ_NULL if there are no more, or MP_OBJ_SENTINEL if some were overwritten
+// before they could be read, in which case every stream may have changed.
+mp_obj_t mp_stream_poll_next_notified(mp_uint_t *seq) {
+    mp_obj_t stream;
+    mp_uint_t atomic_state = MICROPY_BEGIN_ATOMIC_SECTION();
+    mp_uint_t head = stream_poll_notify_seq;
+    if (*seq == head) {
+        stream = MP_OBJ_NULL;
+    } else if (head - *seq > MICROPY_PY_SELECT_POLL_NOTIFY_DEPTH) {
+        stream = MP_OBJ_SENTINEL;
+        *seq = head;
+    } else {
+        stream = stream_poll_notified[*seq & (MICROPY_PY_SELECT_POLL_NOTIFY_DEPTH - 1)];
+        *seq += 1;
+    }
+    MICROPY_END_ATOMIC_SECTION(atomic_state);
+    return stream;
+}
+
+#endif
+
 #if MICROPY_STREAMS_POSIX_API
 /*
  * POSIX-like functions
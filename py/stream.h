@@ -82,6 +82,11 @@ typedef struct _mp_stream_p_t {
     bool pyserial_readinto_compatibility : 1;         // Disallow size parameter in readinto()
     bool pyserial_read_compatibility : 1;             // Disallow omitting read(size) size parameter
     bool pyserial_dont_return_none_compatibility : 1; // Don't return None for read() or readinto()
+    // CIRCUITPY-CHANGE: MP_STREAM_POLL_RD/WR events for which the stream calls
+    // mp_stream_poll_notify() whenever they may have become ready.  Such a stream
+    // must also notify when it hits an error, hangs up or is closed other than by
+    // mp_stream_close().
+    uint8_t poll_notify;
 } mp_stream_p_t;
 
 MP_DECLARE_CONST_FUN_OBJ_VAR_BETWEEN(mp_stream_read_obj);
@@ -118,6 +123,19 @@ mp_obj_t mp_stream_unbuffered_iter(mp_obj_t self);
 
 mp_obj_t mp_stream_write(mp_obj_t self_in, const void *buf, size_t len, byte flags);
 
+// CIRCUITPY-CHANGE: readiness notification for select.poll.  mp_stream_poll_notify()
+// may be called from interrupts; poll sets consume the notifications in order
+// using a sequence number of their own.
+#if MICROPY_PY_SELECT_POLL_NOTIFY
+void mp_stream_poll_notify(mp_obj_t stream);
+mp_uint_t mp_stream_poll_notify_seq(void);
+mp_obj_t mp_stream_poll_next_notified(mp_uint_t *seq);
+#else
+static inline void mp_stream_poll_notify(mp_obj_t stream) {
+    (void)stream;
+}
+#endif
+
 // C-level helper functions
 #define MP_STREAM_RW_READ  0
 #define MP_STREAM_RW_WRITE 2
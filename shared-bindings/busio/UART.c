@@ -183,6 +183,8 @@ static busio_uart_obj_t *native_uart(mp_obj_t uart_obj) {
 static mp_obj_t busio_uart_obj_deinit(mp_obj_t self_in) {
     busio_uart_obj_t *self = native_uart(self_in);
     common_hal_busio_uart_deinit(self);
+    // Wake select.poll so that it sees the UART is gone.
+    mp_stream_poll_notify(self_in);
     return mp_const_none;
 }
 static MP_DEFINE_CONST_FUN_OBJ_1(busio_uart_deinit_obj, busio_uart_obj_deinit);
@@ -447,6 +449,10 @@ static const mp_stream_p_t uart_stream_p = {
     .is_text = false,
     // Disallow optional length argument for .readinto()
     .pyserial_readinto_compatibility = true,
+    #if CIRCUITPY_BUSIO_UART_POLL_NOTIFY
+    // The port notifies when received data arrives. Write readiness is polled.
+    .poll_notify = MP_STREAM_POLL_RD,
+    #endif
 };
 
 MP_DEFINE_CONST_OBJ_TYPE(
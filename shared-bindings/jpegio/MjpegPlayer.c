@@ -0,0 +1,216 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include "py/builtin.h"
+#include "py/objproperty.h"
+#include "py/runtime.h"
+#include "py/stream.h"
+
+#include "shared/runtime/context_manager_helpers.h"
+#include "shared-bindings/displayio/Bitmap.h"
+#include "shared-bindings/jpegio/MjpegPlayer.h"
+#include "shared-bindings/util.h"
+
+//| class MjpegPlayer:
+//|     """Plays a Motion JPEG video one frame at a time
+//|
+//|     The source may be an AVI file containing MJPEG video or a stream of
+//|     concatenated JPEG images, such as the output of
+//|     ``ffmpeg -i clip.mp4 -vf scale=240:-1 -q:v 5 -f mjpeg clip.mjpeg``.
+//|
+//|     Each frame is decoded in the `displayio.Colorspace.RGB565_SWAPPED`
+//|     colorspace. Background tasks keep running while a frame decodes, so by
+//|     alternating between two bitmaps a display with ``auto_refresh`` can send
+//|     one frame while the next is decoded.
+//|
+//|     Example::
+//|
+//|         import board
+//|         import displayio
+//|         import jpegio
+//|
+//|         player = jpegio.MjpegPlayer("/clip.avi", fps=15)
+//|         bitmaps = [displayio.Bitmap(player.width, player.height, 65536) for _ in range(2)]
+//|         tg = displayio.TileGrid(bitmaps[0], pixel_shader=displayio.ColorConverter(
+//|             input_colorspace=displayio.Colorspace.RGB565_SWAPPED))
+//|         board.DISPLAY.root_group = displayio.Group()
+//|         board.DISPLAY.root_group.append(tg)
+//|
+//|         i = 0
+//|         while player.next_frame(bitmaps[i]):
+//|             tg.bitmap = bitmaps[i]
+//|             i = 1 - i
+//|         print(player.frames_decoded, "frames shown,", player.frames_dropped, "dropped")
+//|
+//|     """
+//|
+//|     def __init__(self, source: str | typing.BinaryIO, *, fps: float = 0, scale: int = 0) -> None:
+//|         """Open a video and read its first frame.
+//|
+//|         :param source: A filename or a stream opened in binary mode, such as a file or socket.
+//|         :param float fps: Frames per second to play at. `next_frame` waits until it is time
+//|             to show each frame and skips frames that can no longer be shown in time.
+//|             0 decodes every frame as fast as possible.
+//|         :param int scale: Downscale each frame by a factor of ``2**scale``, from 0 to 3.
+//|         """
+//|         ...
+//|
+static mp_obj_t jpegio_mjpegplayer_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
+    enum { ARG_source, ARG_fps, ARG_scale, NUM_ARGS };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_source, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_fps, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = MP_OBJ_NEW_SMALL_INT(0)} },
+        { MP_QSTR_scale, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
+    };
+    MP_STATIC_ASSERT(MP_ARRAY_SIZE(allowed_args) == NUM_ARGS);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_obj_t source = args[ARG_source].u_obj;
+    if (mp_obj_is_str(source)) {
+        source = mp_call_function_2(MP_OBJ_FROM_PTR(&mp_builtin_open_obj), source, MP_ROM_QSTR(MP_QSTR_rb));
+    }
+    const mp_stream_p_t *proto = mp_get_stream(source);
+    if (proto == NULL || proto->read == NULL || proto->is_text) {
+        mp_raise_TypeError(MP_ERROR_TEXT("file must be a file opened in byte mode"));
+    }
+
+    mp_float_t fps = mp_arg_validate_obj_float_non_negative(args[ARG_fps].u_obj, 0, MP_QSTR_fps);
+    int scale = mp_arg_validate_int_range(args[ARG_scale].u_int, 0, 3, MP_QSTR_scale);
+
+    jpegio_mjpegplayer_obj_t *self = mp_obj_malloc(jpegio_mjpegplayer_obj_t, &jpegio_mjpegplayer_type);
+    common_hal_jpegio_mjpegplayer_construct(self, source, fps, scale);
+
+    return MP_OBJ_FROM_PTR(self);
+}
+
+static void check_for_deinit(jpegio_mjpegplayer_obj_t *self) {
+    if (common_hal_jpegio_mjpegplayer_deinited(self)) {
+        raise_deinited_error();
+    }
+}
+
+//|     def deinit(self) -> None:
+//|         """Release the frame buffer and stop using the source."""
+//|         ...
+//|
+static mp_obj_t jpegio_mjpegplayer_obj_deinit(mp_obj_t self_in) {
+    jpegio_mjpegplayer_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_jpegio_mjpegplayer_deinit(self);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(jpegio_mjpegplayer_deinit_obj, jpegio_mjpegplayer_obj_deinit);
+
+//|     def __enter__(self) -> MjpegPlayer:
+//|         """No-op used by Context Managers."""
+//|         ...
+//|
+//  Provided by context manager helper.
+
+//|     def __exit__(self) -> None:
+//|         """Automatically deinitializes when exiting a context. See
+//|         :ref:`lifetime-and-contextmanagers` for more info."""
+//|         ...
+//|
+//  Provided by context manager helper.
+
+//|     width: int
+//|     """Width of the video before scaling. (read only)"""
+static mp_obj_t jpegio_mjpegplayer_obj_get_width(mp_obj_t self_in) {
+    jpegio_mjpegplayer_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return MP_OBJ_NEW_SMALL_INT(common_hal_jpegio_mjpegplayer_get_width(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(jpegio_mjpegplayer_get_width_obj, jpegio_mjpegplayer_obj_get_width);
+
+MP_PROPERTY_GETTER(jpegio_mjpegplayer_width_obj,
+    (mp_obj_t)&jpegio_mjpegplayer_get_width_obj);
+
+//|     height: int
+//|     """Height of the video before scaling. (read only)"""
+static mp_obj_t jpegio_mjpegplayer_obj_get_height(mp_obj_t self_in) {
+    jpegio_mjpegplayer_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return MP_OBJ_NEW_SMALL_INT(common_hal_jpegio_mjpegplayer_get_height(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(jpegio_mjpegplayer_get_height_obj, jpegio_mjpegplayer_obj_get_height);
+
+MP_PROPERTY_GETTER(jpegio_mjpegplayer_height_obj,
+    (mp_obj_t)&jpegio_mjpegplayer_get_height_obj);
+
+//|     frames_decoded: int
+//|     """Number of frames decoded so far. (read only)"""
+static mp_obj_t jpegio_mjpegplayer_obj_get_frames_decoded(mp_obj_t self_in) {
+    jpegio_mjpegplayer_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_int_from_uint(common_hal_jpegio_mjpegplayer_get_frames_decoded(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(jpegio_mjpegplayer_get_frames_decoded_obj, jpegio_mjpegplayer_obj_get_frames_decoded);
+
+MP_PROPERTY_GETTER(jpegio_mjpegplayer_frames_decoded_obj,
+    (mp_obj_t)&jpegio_mjpegplayer_get_frames_decoded_obj);
+
+//|     frames_dropped: int
+//|     """Number of frames skipped to keep up with ``fps``. (read only)"""
+static mp_obj_t jpegio_mjpegplayer_obj_get_frames_dropped(mp_obj_t self_in) {
+    jpegio_mjpegplayer_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_int_from_uint(common_hal_jpegio_mjpegplayer_get_frames_dropped(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(jpegio_mjpegplayer_get_frames_dropped_obj, jpegio_mjpegplayer_obj_get_frames_dropped);
+
+MP_PROPERTY_GETTER(jpegio_mjpegplayer_frames_dropped_obj,
+    (mp_obj_t)&jpegio_mjpegplayer_get_frames_dropped_obj);
+
+//|     def next_frame(self, bitmap: displayio.Bitmap, x: int = 0, y: int = 0) -> bool:
+//|         """Decode the next frame into ``bitmap`` with its upper-left corner at ``(x, y)``.
+//|
+//|         When ``fps`` is set, this returns once it is time to show the frame.
+//|
+//|         Returns False, leaving ``bitmap`` unchanged, at the end of the video."""
+//|
+//|
+static mp_obj_t jpegio_mjpegplayer_next_frame(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    jpegio_mjpegplayer_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    check_for_deinit(self);
+
+    enum { ARG_bitmap, ARG_x, ARG_y };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_bitmap, MP_ARG_OBJ | MP_ARG_REQUIRED, {.u_obj = mp_const_none } },
+        { MP_QSTR_x, MP_ARG_INT, {.u_int = 0 } },
+        { MP_QSTR_y, MP_ARG_INT, {.u_int = 0 } },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_arg_validate_type(args[ARG_bitmap].u_obj, &displayio_bitmap_type, MP_QSTR_bitmap);
+    displayio_bitmap_t *bitmap = MP_OBJ_TO_PTR(args[ARG_bitmap].u_obj);
+    int x = mp_arg_validate_int_range(args[ARG_x].u_int, 0, bitmap->width, MP_QSTR_x);
+    int y = mp_arg_validate_int_range(args[ARG_y].u_int, 0, bitmap->height, MP_QSTR_y);
+
+    return mp_obj_new_bool(common_hal_jpegio_mjpegplayer_next_frame(self, bitmap, x, y));
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(jpegio_mjpegplayer_next_frame_obj, 1, jpegio_mjpegplayer_next_frame);
+
+static const mp_rom_map_elem_t jpegio_mjpegplayer_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&jpegio_mjpegplayer_deinit_obj) },
+    { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
+    { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&default___exit___obj) },
+    { MP_ROM_QSTR(MP_QSTR_width), MP_ROM_PTR(&jpegio_mjpegplayer_width_obj) },
+    { MP_ROM_QSTR(MP_QSTR_height), MP_ROM_PTR(&jpegio_mjpegplayer_height_obj) },
+    { MP_ROM_QSTR(MP_QSTR_frames_decoded), MP_ROM_PTR(&jpegio_mjpegplayer_frames_decoded_obj) },
+    { MP_ROM_QSTR(MP_QSTR_frames_dropped), MP_ROM_PTR(&jpegio_mjpegplayer_frames_dropped_obj) },
+    { MP_ROM_QSTR(MP_QSTR_next_frame), MP_ROM_PTR(&jpegio_mjpegplayer_next_frame_obj) },
+};
+static MP_DEFINE_CONST_DICT(jpegio_mjpegplayer_locals_dict, jpegio_mjpegplayer_locals_dict_table);
+
+MP_DEFINE_CONST_OBJ_TYPE(
+    jpegio_mjpegplayer_type,
+    MP_QSTR_MjpegPlayer,
+    MP_TYPE_FLAG_HAS_SPECIAL_ACCESSORS,
+    make_new, jpegio_mjpegplayer_make_new,
+    locals_dict, &jpegio_mjpegplayer_locals_dict
+    );
@@ -0,0 +1,22 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "py/obj.h"
+#include "shared-module/displayio/Bitmap.h"
+#include "shared-module/jpegio/MjpegPlayer.h"
+
+extern const mp_obj_type_t jpegio_mjpegplayer_type;
+
+void common_hal_jpegio_mjpegplayer_construct(jpegio_mjpegplayer_obj_t *self, mp_obj_t stream, mp_float_t fps, int scale);
+void common_hal_jpegio_mjpegplayer_deinit(jpegio_mjpegplayer_obj_t *self);
+bool common_hal_jpegio_mjpegplayer_deinited(jpegio_mjpegplayer_obj_t *self);
+uint16_t common_hal_jpegio_mjpegplayer_get_width(jpegio_mjpegplayer_obj_t *self);
+uint16_t common_hal_jpegio_mjpegplayer_get_height(jpegio_mjpegplayer_obj_t *self);
+uint32_t common_hal_jpegio_mjpegplayer_get_frames_decoded(jpegio_mjpegplayer_obj_t *self);
+uint32_t common_hal_jpegio_mjpegplayer_get_frames_dropped(jpegio_mjpegplayer_obj_t *self);
+bool common_hal_jpegio_mjpegplayer_next_frame(jpegio_mjpegplayer_obj_t *self, displayio_bitmap_t *bitmap, int16_t x, int16_t y);
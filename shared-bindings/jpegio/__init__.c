@@ -6,14 +6,16 @@
 
 #include "py/obj.h"
 #include "shared-bindings/jpegio/JpegDecoder.h"
+#include "shared-bindings/jpegio/MjpegPlayer.h"
 
 //|
-//| """Support for JPEG image decoding"""
+//| """Support for JPEG image and Motion JPEG video decoding"""
 //|
 
 static const mp_rom_map_elem_t jpegio_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_jpegio) },
     { MP_ROM_QSTR(MP_QSTR_JpegDecoder), MP_ROM_PTR(&jpegio_jpegdecoder_type) },
+    { MP_ROM_QSTR(MP_QSTR_MjpegPlayer), MP_ROM_PTR(&jpegio_mjpegplayer_type) },
 };
 
 static MP_DEFINE_CONST_DICT(jpegio_module_globals, jpegio_module_globals_table);
@@ -148,6 +148,7 @@ static mp_uint_t eventqueue_ioctl(mp_obj_t self_in, mp_uint_t request, uintptr_t
 
 static const mp_stream_p_t eventqueue_p = {
     .ioctl = eventqueue_ioctl,
+    .poll_notify = MP_STREAM_POLL_RD,
 };
 #endif
 
@@ -18,6 +18,7 @@
 #include "shared-bindings/microcontroller/__init__.h"
 #include "shared-bindings/microcontroller/Pin.h"
 #include "shared-bindings/microcontroller/Processor.h"
+#include "supervisor/shared/serial.h"
 
 //| """Pin references and cpu functionality
 //|
@@ -119,6 +120,8 @@ static MP_DEFINE_CONST_FUN_OBJ_1(mcu_on_next_reset_obj, mcu_on_next_reset);
 //|
 //|
 static mp_obj_t mcu_reset(void) {
+    // Don't lose buffered output, such as the reason for resetting.
+    serial_flush();
     common_hal_mcu_reset();
     // We won't actually get here because we're resetting.
     return mp_const_none;
@@ -50,6 +50,8 @@
 static mp_obj_t socketpool_socket___exit__(size_t n_args, const mp_obj_t *args) {
     (void)n_args;
     common_hal_socketpool_socket_close(args[0]);
+    // Wake select.poll so that it reports the socket as closed.
+    mp_stream_poll_notify(args[0]);
     return mp_const_none;
 }
 static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(socketpool_socket___exit___obj, 4, 4, socketpool_socket___exit__);
@@ -103,6 +105,7 @@ static MP_DEFINE_CONST_FUN_OBJ_2(socketpool_socket_bind_obj, socketpool_socket_b
 static mp_obj_t _socketpool_socket_close(mp_obj_t self_in) {
     socketpool_socket_obj_t *self = MP_OBJ_TO_PTR(self_in);
     common_hal_socketpool_socket_close(self);
+    mp_stream_poll_notify(self_in);
     return mp_const_none;
 }
 static MP_DEFINE_CONST_FUN_OBJ_1(socketpool_socket_close_obj, _socketpool_socket_close);
@@ -452,6 +455,9 @@ static mp_uint_t socket_ioctl(mp_obj_t self_in, mp_uint_t request, uintptr_t arg
     if (request == MP_STREAM_POLL) {
         mp_uint_t flags = arg;
         ret = 0;
+        if (common_hal_socketpool_socket_get_closed(self)) {
+            return MP_STREAM_POLL_NVAL;
+        }
         if ((flags & MP_STREAM_POLL_RD) && common_hal_socketpool_readable(self) > 0) {
             ret |= MP_STREAM_POLL_RD;
         }
@@ -470,6 +476,9 @@ static const mp_stream_p_t socket_stream_p = {
     .write = socket_write,
     .ioctl = socket_ioctl,
     .is_text = false,
+    #if CIRCUITPY_SOCKETPOOL_POLL_NOTIFY
+    .poll_notify = MP_STREAM_POLL_RD | MP_STREAM_POLL_WR,
+    #endif
 };
 
 MP_DEFINE_CONST_OBJ_TYPE(
@@ -11,6 +11,7 @@
 #include "py/objstr.h"
 
 #include "shared/runtime/interrupt_char.h"
+#include "supervisor/background_callback.h"
 #include "supervisor/port.h"
 #include "supervisor/shared/display.h"
 #include "supervisor/shared/reload.h"
@@ -429,6 +430,50 @@ static mp_obj_t supervisor_get_setting(size_t n_args, const mp_obj_t *pos_args,
 }
 MP_DEFINE_CONST_FUN_OBJ_KW(supervisor_get_setting_obj, 1, supervisor_get_setting);
 
+#if CIRCUITPY_BACKGROUND_CALLBACK_STATS
+//| def get_background_stats(reset: bool = False) -> Tuple[Tuple[int, int, int, int, int, int], ...]:
+//|     """Returns how much time has been spent in each kind of background task, as a tuple
+//|     of ``(function_address, priority, runs, total_us, max_us, overruns)`` tuples.
+//|
+//|     ``priority`` is 0 for normal tasks, 1 for audio, 2 for USB, 3 for display refresh and
+//|     4 for filesystem flushes. Audio and USB tasks run first, display refresh and
+//|     filesystem flushes last. ``overruns`` counts the runs that took longer than the
+//|     task's time budget, if it has one.
+//|
+//|     If ``reset`` is True, the counts start over after being returned."""
+//|     ...
+//|
+//|
+static mp_obj_t supervisor_get_background_stats(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_reset };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_reset, MP_ARG_BOOL, {.u_bool = false} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    background_callback_stats_t stats[BACKGROUND_CALLBACK_MAX_STATS];
+    size_t count = background_callback_get_stats(stats, MP_ARRAY_SIZE(stats));
+    if (args[ARG_reset].u_bool) {
+        background_callback_reset_stats();
+    }
+    mp_obj_tuple_t *result = MP_OBJ_TO_PTR(mp_obj_new_tuple(count, NULL));
+    for (size_t i = 0; i < count; i++) {
+        mp_obj_t items[] = {
+            mp_obj_new_int_from_uint((uintptr_t)stats[i].fun),
+            MP_OBJ_NEW_SMALL_INT(stats[i].priority),
+            mp_obj_new_int_from_uint(stats[i].runs),
+            mp_obj_new_int_from_ull(stats[i].total_us),
+            mp_obj_new_int_from_uint(stats[i].max_us),
+            mp_obj_new_int_from_uint(stats[i].overruns),
+        };
+        result->items[i] = mp_obj_new_tuple(MP_ARRAY_SIZE(items), items);
+    }
+    return MP_OBJ_FROM_PTR(result);
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(supervisor_get_background_stats_obj, 0, supervisor_get_background_stats);
+#endif
+
 static const mp_rom_map_elem_t supervisor_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_supervisor) },
     { MP_ROM_QSTR(MP_QSTR_runtime),  MP_ROM_PTR(&common_hal_supervisor_runtime_obj) },
@@ -442,6 +487,9 @@ static const mp_rom_map_elem_t supervisor_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_set_next_code_file),  MP_ROM_PTR(&supervisor_set_next_code_file_obj) },
     { MP_ROM_QSTR(MP_QSTR_ticks_ms),  MP_ROM_PTR(&supervisor_ticks_ms_obj) },
     { MP_ROM_QSTR(MP_QSTR_get_previous_traceback),  MP_ROM_PTR(&supervisor_get_previous_traceback_obj) },
+    #if CIRCUITPY_BACKGROUND_CALLBACK_STATS
+    { MP_ROM_QSTR(MP_QSTR_get_background_stats),  MP_ROM_PTR(&supervisor_get_background_stats_obj) },
+    #endif
     { MP_ROM_QSTR(MP_QSTR_get_setting),  MP_ROM_PTR(&supervisor_get_setting_obj) },
     { MP_ROM_QSTR(MP_QSTR_reset_terminal),  MP_ROM_PTR(&supervisor_reset_terminal_obj) },
     { MP_ROM_QSTR(MP_QSTR_set_usb_identification),  MP_ROM_PTR(&supervisor_set_usb_identification_obj) },
@@ -269,6 +269,7 @@ static const mp_stream_p_t usb_cdc_serial_stream_p = {
     .pyserial_read_compatibility = true,
     .pyserial_readinto_compatibility = true,
     .pyserial_dont_return_none_compatibility = true,
+    .poll_notify = MP_STREAM_POLL_RD | MP_STREAM_POLL_WR,
 };
 
 MP_DEFINE_CONST_OBJ_TYPE(
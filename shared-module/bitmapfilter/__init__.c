@@ -7,6 +7,7 @@
 // SPDX-License-Identifier: MIT
 
 #include <stdbool.h>
+#include <stdlib.h>
 #include <math.h>
 
 #include "py/runtime.h"
@@ -68,15 +69,17 @@ static void *scratchpad_alloc(size_t sz) {
     return scratchpad;
 }
 
-static void scratch_bitmap16(displayio_bitmap_t *buf, int rows, int cols) {
+// Returns a pointer to `extra` additional bytes placed after the rows
+static void *scratch_bitmap16(displayio_bitmap_t *buf, int rows, int cols, size_t extra) {
     int stride = (cols + 1) / 2;
     size_t sz = rows * stride * sizeof(uint32_t);
-    void *data = scratchpad_alloc(sz);
+    void *data = scratchpad_alloc(sz + extra);
     // memset(data, 0, sz);
     buf->width = cols;
     buf->height = rows;
     buf->stride = stride;
     buf->data = data;
+    return (uint8_t *)data + sz;
 }
 
 // https://en.wikipedia.org/wiki/YCbCr -> JPEG Conversion
@@ -88,6 +91,290 @@ uint16_t imlib_yuv_to_rgb(uint8_t y, int8_t u, int8_t v) {
     return COLOR_R8_G8_B8_TO_RGB565(r, g, b);
 }
 
+// Scale, offset and clamp the accumulated channels of one morph output pixel,
+// then apply the optional threshold against the original pixel.
+static inline int morph_finish(int32_t r_acc, int32_t g_acc, int32_t b_acc,
+    const int32_t m_int, const int32_t b_int, bool threshold, int offset, bool invert, int orig) {
+    r_acc = (r_acc * m_int + b_int) >> 16;
+    if (r_acc > COLOR_R5_MAX) {
+        r_acc = COLOR_R5_MAX;
+    } else if (r_acc < 0) {
+        r_acc = 0;
+    }
+    g_acc = (g_acc * m_int + b_int * 2) >> 16;
+    if (g_acc > COLOR_G6_MAX) {
+        g_acc = COLOR_G6_MAX;
+    } else if (g_acc < 0) {
+        g_acc = 0;
+    }
+    b_acc = (b_acc * m_int + b_int) >> 16;
+    if (b_acc > COLOR_B5_MAX) {
+        b_acc = COLOR_B5_MAX;
+    } else if (b_acc < 0) {
+        b_acc = 0;
+    }
+
+    int pixel = COLOR_R5_G6_B5_TO_RGB565(r_acc, g_acc, b_acc);
+
+    if (threshold) {
+        if (((COLOR_RGB565_TO_Y(pixel) - offset) < COLOR_RGB565_TO_Y(orig)) ^ invert) {
+            pixel = COLOR_RGB565_BINARY_MAX;
+        } else {
+            pixel = COLOR_RGB565_BINARY_MIN;
+        }
+    }
+    return pixel;
+}
+
+static int morph_gcd(int a, int b) {
+    a = abs(a);
+    b = abs(b);
+    while (b) {
+        int t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+// Find integer vectors so that krn[j * n + k] == col[j] * row[k], if possible.
+// row is normalized to have no common factor, so any integer kernel of rank 1
+// is found.
+static bool morph_factor_kernel(int n, const int *krn, int *col, int *row) {
+    int p = 0;
+    while (p < n * n && krn[p] == 0) {
+        p++;
+    }
+    if (p == n * n) {
+        return false;
+    }
+    const int *pivot_row = krn + (p / n) * n;
+    int pk = p % n;
+    int g = 0;
+    for (int k = 0; k < n; k++) {
+        g = morph_gcd(g, pivot_row[k]);
+    }
+    if (pivot_row[pk] < 0) {
+        g = -g;
+    }
+    for (int k = 0; k < n; k++) {
+        row[k] = pivot_row[k] / g;
+    }
+    for (int j = 0; j < n; j++) {
+        int c = krn[j * n + pk];
+        if (c % row[pk]) {
+            return false;
+        }
+        col[j] = c / row[pk];
+    }
+    for (int j = 0; j < n; j++) {
+        for (int k = 0; k < n; k++) {
+            if (krn[j * n + k] != col[j] * row[k]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static bool morph_uniform(int n, const int *v) {
+    for (int i = 1; i < n; i++) {
+        if (v[i] != v[0]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Packed representation for processing all three channels of a pixel with a
+// single 32-bit add or multiply: B in bits 0-9, R in bits 10-20, G in bits
+// 21-31. Sums with non-negative weights stay exact as long as no lane
+// overflows, i.e. while the sum of the weights times COLOR_G6_MAX is below
+// 1 << 11 (which also keeps R and B below 1 << 10).
+#define MORPH_SWAR_MAX_WEIGHT (((1 << 11) - 1) / COLOR_G6_MAX)
+#define MORPH_SWAR_SPREAD(pixel) \
+    ((((uint32_t)(pixel) & 0x07e0) << 16) | (((pixel) & 0xf800) >> 1) | ((pixel) & 0x001f))
+#define MORPH_SWAR_R(v) (((v) >> 10) & 0x7ff)
+#define MORPH_SWAR_G(v) ((v) >> 21)
+#define MORPH_SWAR_B(v) ((v) & 0x3ff)
+
+// A separable kernel is applied as a vertical pass into one accumulator per
+// column followed by a horizontal pass over those accumulators, so each pixel
+// costs 2 * (2 * ksize + 1) multiply-adds instead of (2 * ksize + 1) ** 2. When
+// either vector is uniform (a box filter) its pass is a running sum, costing
+// the same for any ksize. The sums are exactly those of the 2-D kernel, so the
+// output is identical to the generic path.
+static void morph_separable(
+    displayio_bitmap_t *bitmap,
+    displayio_bitmap_t *mask,
+    const int ksize,
+    const int *col,
+    const int *row,
+    const int32_t m_int,
+    const int32_t b_int,
+    bool threshold,
+    int offset,
+    bool invert) {
+
+    const int n = 2 * ksize + 1;
+    const int width = bitmap->width, height = bitmap->height;
+    const int brows = ksize + 1;
+    const bool col_box = morph_uniform(n, col);
+    const bool row_box = morph_uniform(n, row);
+
+    int col_sum = 0, row_sum = 0;
+    bool swar = true;
+    for (int i = 0; i < n; i++) {
+        swar = swar && col[i] >= 0 && row[i] >= 0;
+        col_sum += col[i];
+        row_sum += row[i];
+    }
+    swar = swar && col_sum * row_sum <= MORPH_SWAR_MAX_WEIGHT;
+
+    // One packed accumulator per column, or one per channel per column.
+    displayio_bitmap_t buf;
+    int32_t *acc = scratch_bitmap16(&buf, brows, width, (swar ? 1 : 3) * width * sizeof(int32_t));
+    uint32_t *acc_swar = (uint32_t *)acc;
+    int32_t *acc_r = acc, *acc_g = acc + width, *acc_b = acc + 2 * width;
+
+    for (int y = 0; y < height; y++) {
+        uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(bitmap, y);
+        uint16_t *buf_row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(&buf, (y % brows));
+
+        // Vertical pass. A box column is instead updated incrementally below.
+        if (y == 0 || !col_box) {
+            memset(acc, 0, (swar ? 1 : 3) * width * sizeof(int32_t));
+            for (int j = -ksize; j <= ksize; j++) {
+                int wt = col[j + ksize];
+                if (!wt) {
+                    continue;
+                }
+                uint16_t *k_row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(bitmap,
+                    IM_MIN(IM_MAX(y + j, 0), (height - 1)));
+                if (swar) {
+                    for (int x = 0; x < width; x++) {
+                        int pixel = IMAGE_GET_RGB565_PIXEL_FAST(k_row_ptr, x);
+                        acc_swar[x] += wt * MORPH_SWAR_SPREAD(pixel);
+                    }
+                } else {
+                    for (int x = 0; x < width; x++) {
+                        int pixel = IMAGE_GET_RGB565_PIXEL_FAST(k_row_ptr, x);
+                        acc_r[x] += wt * COLOR_RGB565_TO_R5(pixel);
+                        acc_g[x] += wt * COLOR_RGB565_TO_G6(pixel);
+                        acc_b[x] += wt * COLOR_RGB565_TO_B5(pixel);
+                    }
+                }
+            }
+        }
+
+        // Horizontal pass, finishing each output pixel.
+        uint32_t run_swar = 0;
+        int32_t run_r = 0, run_g = 0, run_b = 0;
+        for (int x = 0; x < width; x++) {
+            int32_t r_acc, g_acc, b_acc;
+            if (row_box) {
+                // Sliding window sum over the clamped neighborhood.
+                if (x == 0) {
+                    for (int k = -ksize; k <= ksize; k++) {
+                        int xk = IM_MIN(IM_MAX(k, 0), (width - 1));
+                        if (swar) {
+                            run_swar += acc_swar[xk];
+                        } else {
+                            run_r += acc_r[xk];
+                            run_g += acc_g[xk];
+                            run_b += acc_b[xk];
+                        }
+                    }
+                } else {
+                    int x_out = IM_MAX(x - ksize - 1, 0);
+                    int x_in = IM_MIN(x + ksize, (width - 1));
+                    if (swar) {
+                        run_swar += acc_swar[x_in] - acc_swar[x_out];
+                    } else {
+                        run_r += acc_r[x_in] - acc_r[x_out];
+                        run_g += acc_g[x_in] - acc_g[x_out];
+                        run_b += acc_b[x_in] - acc_b[x_out];
+                    }
+                }
+                if (swar) {
+                    uint32_t v = row[0] * run_swar;
+                    r_acc = MORPH_SWAR_R(v);
+                    g_acc = MORPH_SWAR_G(v);
+                    b_acc = MORPH_SWAR_B(v);
+                } else {
+                    r_acc = row[0] * run_r;
+                    g_acc = row[0] * run_g;
+                    b_acc = row[0] * run_b;
+                }
+            } else if (swar) {
+                uint32_t v = 0;
+                if (x >= ksize && x < width - ksize) {
+                    for (int k = -ksize; k <= ksize; k++) {
+                        v += row[k + ksize] * acc_swar[x + k];
+                    }
+                } else {
+                    for (int k = -ksize; k <= ksize; k++) {
+                        v += row[k + ksize] * acc_swar[IM_MIN(IM_MAX(x + k, 0), (width - 1))];
+                    }
+                }
+                r_acc = MORPH_SWAR_R(v);
+                g_acc = MORPH_SWAR_G(v);
+                b_acc = MORPH_SWAR_B(v);
+            } else {
+                r_acc = g_acc = b_acc = 0;
+                for (int k = -ksize; k <= ksize; k++) {
+                    int xk = IM_MIN(IM_MAX(x + k, 0), (width - 1));
+                    r_acc += row[k + ksize] * acc_r[xk];
+                    g_acc += row[k + ksize] * acc_g[xk];
+                    b_acc += row[k + ksize] * acc_b[xk];
+                }
+            }
+
+            int pixel = IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x);
+            if (!(mask && common_hal_displayio_bitmap_get_pixel(mask, x, y))) {
+                pixel = morph_finish(r_acc, g_acc, b_acc, m_int, b_int, threshold, offset, invert, pixel);
+            }
+            IMAGE_PUT_RGB565_PIXEL_FAST(buf_row_ptr, x, pixel);
+        }
+
+        // Slide a box column down one row. This reads row y - ksize, so it
+        // must happen before that row is overwritten with its result.
+        if (col_box && y + 1 < height) {
+            uint16_t *out_row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(bitmap, IM_MAX(y - ksize, 0));
+            uint16_t *in_row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(bitmap, IM_MIN(y + ksize + 1, (height - 1)));
+            int wt = col[0];
+            if (swar) {
+                for (int x = 0; x < width; x++) {
+                    int pixel_out = IMAGE_GET_RGB565_PIXEL_FAST(out_row_ptr, x);
+                    int pixel_in = IMAGE_GET_RGB565_PIXEL_FAST(in_row_ptr, x);
+                    acc_swar[x] += wt * (MORPH_SWAR_SPREAD(pixel_in) - MORPH_SWAR_SPREAD(pixel_out));
+                }
+            } else {
+                for (int x = 0; x < width; x++) {
+                    int pixel_out = IMAGE_GET_RGB565_PIXEL_FAST(out_row_ptr, x);
+                    int pixel_in = IMAGE_GET_RGB565_PIXEL_FAST(in_row_ptr, x);
+                    acc_r[x] += wt * (COLOR_RGB565_TO_R5(pixel_in) - COLOR_RGB565_TO_R5(pixel_out));
+                    acc_g[x] += wt * (COLOR_RGB565_TO_G6(pixel_in) - COLOR_RGB565_TO_G6(pixel_out));
+                    acc_b[x] += wt * (COLOR_RGB565_TO_B5(pixel_in) - COLOR_RGB565_TO_B5(pixel_out));
+                }
+            }
+        }
+
+        if (y >= ksize) {     // Transfer buffer lines...
+            memcpy(IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(bitmap, (y - ksize)),
+                IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(&buf, ((y - ksize) % brows)),
+                IMAGE_RGB565_LINE_LEN_BYTES(bitmap));
+        }
+    }
+
+    // Copy any remaining lines from the buffer image...
+    for (int y = IM_MAX(height - ksize, 0), yy = height; y < yy; y++) {
+        memcpy(IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(bitmap, y),
+            IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(&buf, (y % brows)),
+            IMAGE_RGB565_LINE_LEN_BYTES(bitmap));
+    }
+}
+
 void shared_module_bitmapfilter_morph(
     displayio_bitmap_t *bitmap,
     displayio_bitmap_t *mask,
@@ -108,8 +395,14 @@ void shared_module_bitmapfilter_morph(
         default:
             mp_raise_ValueError(MP_ERROR_TEXT("unsupported bitmap depth"));
         case 16: {
+            int col[2 * ksize + 1], row[2 * ksize + 1];
+            if (morph_factor_kernel(2 * ksize + 1, krn, col, row)) {
+                morph_separable(bitmap, mask, ksize, col, row, m_int, b_int, threshold, offset, invert);
+                break;
+            }
+
             displayio_bitmap_t buf;
-            scratch_bitmap16(&buf, brows, bitmap->width);
+            scratch_bitmap16(&buf, brows, bitmap->width, 0);
 
             for (int y = 0, yy = bitmap->height; y < yy; y++) {
                 uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(bitmap, y);
@@ -146,35 +439,8 @@ void shared_module_bitmapfilter_morph(
                             }
                         }
                     }
-                    r_acc = (r_acc * m_int + b_int) >> 16;
-                    if (r_acc > COLOR_R5_MAX) {
-                        r_acc = COLOR_R5_MAX;
-                    } else if (r_acc < 0) {
-                        r_acc = 0;
-                    }
-                    g_acc = (g_acc * m_int + b_int * 2) >> 16;
-                    if (g_acc > COLOR_G6_MAX) {
-                        g_acc = COLOR_G6_MAX;
-                    } else if (g_acc < 0) {
-                        g_acc = 0;
-                    }
-                    b_acc = (b_acc * m_int + b_int) >> 16;
-                    if (b_acc > COLOR_B5_MAX) {
-                        b_acc = COLOR_B5_MAX;
-                    } else if (b_acc < 0) {
-                        b_acc = 0;
-                    }
-
-                    int pixel = COLOR_R5_G6_B5_TO_RGB565(r_acc, g_acc, b_acc);
-
-                    if (threshold) {
-                        if (((COLOR_RGB565_TO_Y(pixel) - offset) < COLOR_RGB565_TO_Y(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x))) ^ invert) {
-                            pixel = COLOR_RGB565_BINARY_MAX;
-                        } else {
-                            pixel = COLOR_RGB565_BINARY_MIN;
-                        }
-                    }
-
+                    int pixel = morph_finish(r_acc, g_acc, b_acc, m_int, b_int,
+                        threshold, offset, invert, IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x));
                     IMAGE_PUT_RGB565_PIXEL_FAST(buf_row_ptr, x, pixel);
                 }
 
@@ -6,11 +6,25 @@
 
 #include "shared-bindings/displayio/Palette.h"
 
+#include <string.h>
+
+#include "py/gc.h"
 #include "shared-module/displayio/ColorConverter.h"
 
 void common_hal_displayio_palette_construct(displayio_palette_t *self, uint16_t color_count, bool dither) {
     self->color_count = color_count;
     self->colors = (_displayio_color_t *)m_malloc_without_collect(color_count * sizeof(_displayio_color_t));
+    size_t transparent_size = (color_count + 31) / 32 * sizeof(uint32_t);
+    self->transparent = (uint32_t *)m_malloc_without_collect(transparent_size);
+    memset(self->transparent, 0, transparent_size);
+    for (size_t i = 0; i < DISPLAYIO_PALETTE_LUT_COUNT; i++) {
+        self->luts[i].colorspace = NULL;
+        self->luts[i].colors = NULL;
+    }
+    self->failed_lut.colorspace = NULL;
+    self->failed_lut.colors = NULL;
+    self->next_lut = 0;
+    self->generation = 0;
     self->dither = dither;
 }
 
@@ -23,17 +37,17 @@ bool common_hal_displayio_palette_get_dither(displayio_palette_t *self) {
 }
 
 void common_hal_displayio_palette_make_opaque(displayio_palette_t *self, uint32_t palette_index) {
-    self->colors[palette_index].transparent = false;
+    self->transparent[palette_index / 32] &= ~(1u << (palette_index % 32));
     self->needs_refresh = true;
 }
 
 void common_hal_displayio_palette_make_transparent(displayio_palette_t *self, uint32_t palette_index) {
-    self->colors[palette_index].transparent = true;
+    self->transparent[palette_index / 32] |= 1u << (palette_index % 32);
     self->needs_refresh = true;
 }
 
 bool common_hal_displayio_palette_is_transparent(displayio_palette_t *self, uint32_t palette_index) {
-    return self->colors[palette_index].transparent;
+    return displayio_palette_index_is_transparent(self, palette_index);
 }
 
 uint32_t common_hal_displayio_palette_get_len(displayio_palette_t *self) {
@@ -46,6 +60,7 @@ void common_hal_displayio_palette_set_color(displayio_palette_t *self, uint32_t
     }
     self->colors[palette_index].rgb888 = color;
     self->colors[palette_index].cached_colorspace = NULL;
+    self->generation++;
     self->needs_refresh = true;
 }
 
@@ -53,27 +68,99 @@ uint32_t common_hal_displayio_palette_get_color(displayio_palette_t *self, uint3
     return self->colors[palette_index].rgb888;
 }
 
+static bool lut_is_current(const displayio_palette_t *self, const displayio_palette_lut_t *lut, const _displayio_colorspace_t *colorspace) {
+    // Check the grayscale settings because EPaperDisplay will change them on
+    // the same object.
+    return lut->colorspace == colorspace &&
+           lut->generation == self->generation &&
+           lut->grayscale_bit == colorspace->grayscale_bit &&
+           lut->grayscale == colorspace->grayscale;
+}
+
+static void lut_set_current(const displayio_palette_t *self, displayio_palette_lut_t *lut, const _displayio_colorspace_t *colorspace) {
+    lut->colorspace = colorspace;
+    lut->generation = self->generation;
+    lut->grayscale_bit = colorspace->grayscale_bit;
+    lut->grayscale = colorspace->grayscale;
+}
+
+const uint32_t *displayio_palette_get_lut(displayio_palette_t *self, const _displayio_colorspace_t *colorspace) {
+    // Dithered colors depend on the pixel location so they can't be tabled.
+    // Tables live on the VM heap, so only palettes there that keep them
+    // alive can have one, and only while there is a heap to allocate from.
+    if (self->dither || !gc_alloc_possible() || !gc_ptr_on_heap(self) ||
+        lut_is_current(self, &self->failed_lut, colorspace)) {
+        return NULL;
+    }
+
+    displayio_palette_lut_t *lut = NULL;
+    for (size_t i = 0; i < DISPLAYIO_PALETTE_LUT_COUNT; i++) {
+        if (self->luts[i].colorspace == colorspace) {
+            lut = &self->luts[i];
+            break;
+        }
+    }
+    if (lut != NULL && lut_is_current(self, lut, colorspace)) {
+        return lut->colors;
+    }
+
+    if (lut == NULL) {
+        // Replace the table that was built longest ago.
+        lut = &self->luts[self->next_lut];
+        self->next_lut = (self->next_lut + 1) % DISPLAYIO_PALETTE_LUT_COUNT;
+        lut->colorspace = NULL;
+    }
+    if (lut->colors == NULL) {
+        // This may be called from a background refresh so we can't raise.
+        lut->colors = m_malloc_maybe_without_collect(self->color_count * sizeof(uint32_t));
+        if (lut->colors == NULL) {
+            lut_set_current(self, &self->failed_lut, colorspace);
+            return NULL;
+        }
+    }
+
+    displayio_input_pixel_t input_pixel = { 0 };
+    displayio_output_pixel_t output_pixel;
+    for (uint32_t i = 0; i < self->color_count; i++) {
+        input_pixel.pixel = self->colors[i].rgb888;
+        displayio_convert_color(colorspace, false, &input_pixel, &output_pixel);
+        if (!output_pixel.opaque) {
+            // The colorspace isn't supported by the converter.
+            lut->colorspace = NULL;
+            lut_set_current(self, &self->failed_lut, colorspace);
+            return NULL;
+        }
+        lut->colors[i] = output_pixel.pixel;
+    }
+    lut_set_current(self, lut, colorspace);
+    return lut->colors;
+}
+
 void displayio_palette_get_color(displayio_palette_t *self, const _displayio_colorspace_t *colorspace, const displayio_input_pixel_t *input_pixel, displayio_output_pixel_t *output_color) {
     uint32_t palette_index = input_pixel->pixel;
-    if (palette_index > self->color_count || self->colors[palette_index].transparent) {
+    if (displayio_palette_index_is_transparent(self, palette_index)) {
         output_color->opaque = false;
         return;
     }
 
-    // Cache results when not dithering.
+    const uint32_t *lut = displayio_palette_get_lut(self, colorspace);
+    if (lut != NULL) {
+        output_color->pixel = lut[palette_index];
+        return;
+    }
+
+    // Otherwise cache each color on its own when not dithering.
     _displayio_color_t *color = &self->colors[palette_index];
-    // Check the grayscale settings because EPaperDisplay will change them on
-    // the same object.
     if (!self->dither &&
         color->cached_colorspace == colorspace &&
         color->cached_colorspace_grayscale_bit == colorspace->grayscale_bit &&
         color->cached_colorspace_grayscale == colorspace->grayscale) {
-        output_color->pixel = self->colors[palette_index].cached_color;
+        output_color->pixel = color->cached_color;
         return;
     }
 
     displayio_input_pixel_t rgb888_pixel = *input_pixel;
-    rgb888_pixel.pixel = self->colors[palette_index].rgb888;
+    rgb888_pixel.pixel = color->rgb888;
     displayio_convert_color(colorspace, self->dither, &rgb888_pixel, output_color);
     if (!self->dither) {
         color->cached_colorspace = colorspace;
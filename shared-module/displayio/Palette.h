@@ -30,11 +30,11 @@ typedef struct {
 
 typedef struct {
     uint32_t rgb888;
+    // Used when the palette can't have a table of converted colors.
     const _displayio_colorspace_t *cached_colorspace;
     uint32_t cached_color;
     uint8_t cached_colorspace_grayscale_bit;
     bool cached_colorspace_grayscale;
-    bool transparent; // This may have additional bits added later for blending.
 } _displayio_color_t;
 
 typedef struct {
@@ -51,16 +51,48 @@ typedef struct {
     bool opaque;
 } displayio_output_pixel_t;
 
+// Number of colorspaces a palette keeps converted colors for at once. Two
+// covers a palette shown on two different displays without thrashing.
+#define DISPLAYIO_PALETTE_LUT_COUNT (2)
+
+// All of a palette's colors converted for one colorspace. It is valid while
+// the palette's generation matches and the colorspace's grayscale settings
+// haven't changed. (EPaperDisplay changes them on the same object.)
+typedef struct {
+    const _displayio_colorspace_t *colorspace;
+    uint32_t *colors;
+    uint32_t generation;
+    uint8_t grayscale_bit;
+    bool grayscale;
+} displayio_palette_lut_t;
+
 typedef struct displayio_palette {
     mp_obj_base_t base;
     _displayio_color_t *colors;
+    uint32_t *transparent; // One bit per color. NULL when none are transparent.
+    displayio_palette_lut_t luts[DISPLAYIO_PALETTE_LUT_COUNT];
+    // The last colorspace a table couldn't be built or allocated for, so it
+    // isn't retried for every pixel. Its colors are unused.
+    displayio_palette_lut_t failed_lut;
     uint32_t color_count;
+    uint32_t generation; // Incremented whenever a color value changes.
+    uint8_t next_lut;
     bool needs_refresh;
     bool dither;
 } displayio_palette_t;
 
+static inline bool displayio_palette_index_is_transparent(const displayio_palette_t *self, uint32_t palette_index) {
+    return palette_index >= self->color_count ||
+           (self->transparent != NULL && (self->transparent[palette_index / 32] & (1u << (palette_index % 32))) != 0);
+}
 
+// Returns the palette's colors converted for the given colorspace, indexed by
+// palette index. Returns NULL when dithering (the result depends on pixel
+// position), for static palettes that aren't on the VM heap, or when the
+// table can't be built. A failure is remembered until the palette or the
+// colorspace changes. Transparency isn't encoded in the table, check
+// displayio_palette_index_is_transparent() first.
+const uint32_t *displayio_palette_get_lut(displayio_palette_t *self, const _displayio_colorspace_t *colorspace);
 void displayio_palette_get_color(displayio_palette_t *palette, const _displayio_colorspace_t *colorspace, const displayio_input_pixel_t *input_pixel, displayio_output_pixel_t *output_color);
-;
 bool displayio_palette_needs_refresh(displayio_palette_t *self);
 void displayio_palette_finish_refresh(displayio_palette_t *self);
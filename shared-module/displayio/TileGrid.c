@@ -70,6 +70,14 @@ void common_hal_displayio_tilegrid_construct(displayio_tilegrid_t *self, mp_obj_
     self->pixel_height = height * tile_height;
     self->tile_width = tile_width;
     self->tile_height = tile_height;
+    self->dirty_rows = NULL;
+    self->rows_changed = false;
+    // Track changes per row when there is more than one so that scattered updates (like a
+    // scrolling terminal) don't grow into one dirty area covering the whole grid.
+    if (!self->inline_tiles && height > 1) {
+        displayio_tilegrid_set_dirty_rows(self,
+            (displayio_area_t *)m_malloc_without_collect(height * sizeof(displayio_area_t)));
+    }
     self->bitmap = bitmap;
     self->pixel_shader = pixel_shader;
     self->in_group = false;
@@ -285,7 +293,42 @@ uint16_t common_hal_displayio_tilegrid_get_tile(displayio_tilegrid_t *self, uint
     }
 }
 
-void displayio_tilegrid_mark_tile_dirty(displayio_tilegrid_t *self, uint16_t x, uint16_t y) {
+static void _reset_dirty_rows(displayio_tilegrid_t *self) {
+    for (uint16_t ty = 0; ty < self->height_in_tiles; ty++) {
+        displayio_area_t *row = &self->dirty_rows[ty];
+        row->x1 = 0;
+        row->x2 = 0;
+        row->y1 = ty * self->tile_height;
+        row->y2 = row->y1 + self->tile_height;
+        row->next = NULL;
+    }
+    self->rows_changed = false;
+}
+
+void displayio_tilegrid_set_dirty_rows(displayio_tilegrid_t *self, displayio_area_t *dirty_rows) {
+    self->dirty_rows = dirty_rows;
+    if (dirty_rows != NULL) {
+        _reset_dirty_rows(self);
+    }
+}
+
+// tx and ty are the on-screen position of the tile, after applying top_left.
+static void _mark_screen_tile_dirty(displayio_tilegrid_t *self, uint16_t tx, uint16_t ty) {
+    int16_t x1 = tx * self->tile_width;
+    int16_t x2 = x1 + self->tile_width;
+    if (self->dirty_rows != NULL) {
+        displayio_area_t *row = &self->dirty_rows[ty];
+        if (displayio_area_empty(row)) {
+            row->x1 = x1;
+            row->x2 = x2;
+        } else {
+            row->x1 = MIN(row->x1, x1);
+            row->x2 = MAX(row->x2, x2);
+        }
+        self->rows_changed = true;
+        return;
+    }
+
     displayio_area_t temp_area;
     displayio_area_t *tile_area;
     if (!self->partial_change) {
@@ -293,23 +336,27 @@ void displayio_tilegrid_mark_tile_dirty(displayio_tilegrid_t *self, uint16_t x,
     } else {
         tile_area = &temp_area;
     }
+    tile_area->x1 = x1;
+    tile_area->x2 = x2;
+    tile_area->y1 = ty * self->tile_height;
+    tile_area->y2 = tile_area->y1 + self->tile_height;
+
+    if (self->partial_change) {
+        displayio_area_union(&self->dirty_area, &temp_area, &self->dirty_area);
+    }
+    self->partial_change = true;
+}
+
+void displayio_tilegrid_mark_tile_dirty(displayio_tilegrid_t *self, uint16_t x, uint16_t y) {
     int16_t tx = (x - self->top_left_x) % self->width_in_tiles;
     if (tx < 0) {
         tx += self->width_in_tiles;
     }
-    tile_area->x1 = tx * self->tile_width;
-    tile_area->x2 = tile_area->x1 + self->tile_width;
     int16_t ty = (y - self->top_left_y) % self->height_in_tiles;
     if (ty < 0) {
         ty += self->height_in_tiles;
     }
-    tile_area->y1 = ty * self->tile_height;
-    tile_area->y2 = tile_area->y1 + self->tile_height;
-
-    if (self->partial_change) {
-        displayio_area_union(&self->dirty_area, &temp_area, &self->dirty_area);
-    }
-    self->partial_change = true;
+    _mark_screen_tile_dirty(self, tx, ty);
 }
 
 void common_hal_displayio_tilegrid_set_tile(displayio_tilegrid_t *self, uint16_t x, uint16_t y, uint16_t tile_index) {
@@ -327,8 +374,14 @@ void common_hal_displayio_tilegrid_set_tile(displayio_tilegrid_t *self, uint16_t
 
     uint32_t index = y * self->width_in_tiles + x;
     if (self->tiles_in_bitmap > 255) {
+        if (((uint16_t *)tiles)[index] == tile_index) {
+            return;
+        }
         ((uint16_t *)tiles)[index] = tile_index;
     } else {
+        if (((uint8_t *)tiles)[index] == tile_index) {
+            return;
+        }
         ((uint8_t *)tiles)[index] = (uint8_t)tile_index;
     }
     displayio_tilegrid_mark_tile_dirty(self, x, y);
@@ -420,9 +473,38 @@ bool common_hal_displayio_tilegrid_contains(displayio_tilegrid_t *self, uint16_t
 }
 
 void common_hal_displayio_tilegrid_set_top_left(displayio_tilegrid_t *self, uint16_t x, uint16_t y) {
+    bool mapped = false;
+    #if CIRCUITPY_TILEPALETTEMAPPER
+    // Mapped colors follow the tile's position in the grid, so the same tile
+    // can look different after a move.
+    mapped = mp_obj_is_type(self->pixel_shader, &tilepalettemapper_tilepalettemapper_type);
+    #endif
+    if (self->dirty_rows == NULL || self->full_change || mapped) {
+        self->top_left_x = x;
+        self->top_left_y = y;
+        self->full_change = true;
+        return;
+    }
+
+    // Compare what each on-screen tile shows before and after the move and only
+    // redraw the ones that differ. Scrolling text mostly moves blank tiles over
+    // blank tiles.
+    uint16_t old_x = self->top_left_x;
+    uint16_t old_y = self->top_left_y;
     self->top_left_x = x;
     self->top_left_y = y;
-    self->full_change = true;
+    for (uint16_t ty = 0; ty < self->height_in_tiles; ty++) {
+        uint16_t old_row = (ty + old_y) % self->height_in_tiles;
+        uint16_t new_row = (ty + y) % self->height_in_tiles;
+        for (uint16_t tx = 0; tx < self->width_in_tiles; tx++) {
+            uint16_t old_col = (tx + old_x) % self->width_in_tiles;
+            uint16_t new_col = (tx + x) % self->width_in_tiles;
+            if (common_hal_displayio_tilegrid_get_tile(self, old_col, old_row) !=
+                common_hal_displayio_tilegrid_get_tile(self, new_col, new_row)) {
+                _mark_screen_tile_dirty(self, tx, ty);
+            }
+        }
+    }
 }
 
 bool displayio_tilegrid_fill_area(displayio_tilegrid_t *self,
@@ -512,6 +594,14 @@ bool displayio_tilegrid_fill_area(displayio_tilegrid_t *self,
         y_shift = temp_shift;
     }
 
+    // Non-dithered palettes are converted up front so each pixel is a single table load.
+    displayio_palette_t *palette = NULL;
+    const uint32_t *palette_lut = NULL;
+    if (mp_obj_is_type(self->pixel_shader, &displayio_palette_type)) {
+        palette = self->pixel_shader;
+        palette_lut = displayio_palette_get_lut(palette, colorspace);
+    }
+
     displayio_input_pixel_t input_pixel;
     displayio_output_pixel_t output_pixel;
 
@@ -563,8 +653,14 @@ bool displayio_tilegrid_fill_area(displayio_tilegrid_t *self,
             #endif
             if (self->pixel_shader == mp_const_none) {
                 output_pixel.pixel = input_pixel.pixel;
-            } else if (mp_obj_is_type(self->pixel_shader, &displayio_palette_type)) {
-                displayio_palette_get_color(self->pixel_shader, colorspace, &input_pixel, &output_pixel);
+            } else if (palette_lut != NULL) {
+                if (displayio_palette_index_is_transparent(palette, input_pixel.pixel)) {
+                    output_pixel.opaque = false;
+                } else {
+                    output_pixel.pixel = palette_lut[input_pixel.pixel];
+                }
+            } else if (palette != NULL) {
+                displayio_palette_get_color(palette, colorspace, &input_pixel, &output_pixel);
             } else if (mp_obj_is_type(self->pixel_shader, &displayio_colorconverter_type)) {
                 displayio_colorconverter_convert(self->pixel_shader, colorspace, &input_pixel, &output_pixel);
             }
@@ -621,6 +717,9 @@ void displayio_tilegrid_finish_refresh(displayio_tilegrid_t *self) {
     self->moved = false;
     self->full_change = false;
     self->partial_change = false;
+    if (self->rows_changed) {
+        _reset_dirty_rows(self);
+    }
     if (mp_obj_is_type(self->pixel_shader, &displayio_palette_type)) {
         displayio_palette_finish_refresh(self->pixel_shader);
     } else if (mp_obj_is_type(self->pixel_shader, &displayio_colorconverter_type)) {
@@ -636,6 +735,50 @@ void displayio_tilegrid_finish_refresh(displayio_tilegrid_t *self) {
     // That way they won't change during a refresh and tear.
 }
 
+// Converts an area relative to the TileGrid into absolute screen coordinates.
+static void _transform_dirty_area(displayio_tilegrid_t *self, displayio_area_t *area) {
+    int16_t x = self->x;
+    int16_t y = self->y;
+    if (self->absolute_transform->transpose_xy) {
+        int16_t temp = y;
+        y = x;
+        x = temp;
+    }
+    int16_t x1 = area->x1;
+    int16_t x2 = area->x2;
+    if (self->flip_x) {
+        x1 = self->pixel_width - x1;
+        x2 = self->pixel_width - x2;
+    }
+    int16_t y1 = area->y1;
+    int16_t y2 = area->y2;
+    if (self->flip_y) {
+        y1 = self->pixel_height - y1;
+        y2 = self->pixel_height - y2;
+    }
+    if (self->transpose_xy != self->absolute_transform->transpose_xy) {
+        int16_t temp1 = y1, temp2 = y2;
+        y1 = x1;
+        x1 = temp1;
+        y2 = x2;
+        x2 = temp2;
+    }
+    area->x1 = self->absolute_transform->x + self->absolute_transform->dx * (x + x1);
+    area->y1 = self->absolute_transform->y + self->absolute_transform->dy * (y + y1);
+    area->x2 = self->absolute_transform->x + self->absolute_transform->dx * (x + x2);
+    area->y2 = self->absolute_transform->y + self->absolute_transform->dy * (y + y2);
+    if (area->y2 < area->y1) {
+        int16_t temp = area->y2;
+        area->y2 = area->y1;
+        area->y1 = temp;
+    }
+    if (area->x2 < area->x1) {
+        int16_t temp = area->x2;
+        area->x2 = area->x1;
+        area->x1 = temp;
+    }
+}
+
 displayio_area_t *displayio_tilegrid_get_refresh_areas(displayio_tilegrid_t *self, displayio_area_t *tail) {
     bool first_draw = self->previous_area.x1 == self->previous_area.x2;
     bool hidden = self->hidden || self->hidden_by_parent;
@@ -686,49 +829,21 @@ displayio_area_t *displayio_tilegrid_get_refresh_areas(displayio_tilegrid_t *sel
     }
 
     if (self->partial_change) {
-        int16_t x = self->x;
-        int16_t y = self->y;
-        if (self->absolute_transform->transpose_xy) {
-            int16_t temp = y;
-            y = x;
-            x = temp;
-        }
-        int16_t x1 = self->dirty_area.x1;
-        int16_t x2 = self->dirty_area.x2;
-        if (self->flip_x) {
-            x1 = self->pixel_width - x1;
-            x2 = self->pixel_width - x2;
-        }
-        int16_t y1 = self->dirty_area.y1;
-        int16_t y2 = self->dirty_area.y2;
-        if (self->flip_y) {
-            y1 = self->pixel_height - y1;
-            y2 = self->pixel_height - y2;
-        }
-        if (self->transpose_xy != self->absolute_transform->transpose_xy) {
-            int16_t temp1 = y1, temp2 = y2;
-            y1 = x1;
-            x1 = temp1;
-            y2 = x2;
-            x2 = temp2;
-        }
-        self->dirty_area.x1 = self->absolute_transform->x + self->absolute_transform->dx * (x + x1);
-        self->dirty_area.y1 = self->absolute_transform->y + self->absolute_transform->dy * (y + y1);
-        self->dirty_area.x2 = self->absolute_transform->x + self->absolute_transform->dx * (x + x2);
-        self->dirty_area.y2 = self->absolute_transform->y + self->absolute_transform->dy * (y + y2);
-        if (self->dirty_area.y2 < self->dirty_area.y1) {
-            int16_t temp = self->dirty_area.y2;
-            self->dirty_area.y2 = self->dirty_area.y1;
-            self->dirty_area.y1 = temp;
-        }
-        if (self->dirty_area.x2 < self->dirty_area.x1) {
-            int16_t temp = self->dirty_area.x2;
-            self->dirty_area.x2 = self->dirty_area.x1;
-            self->dirty_area.x1 = temp;
-        }
-
+        _transform_dirty_area(self, &self->dirty_area);
         self->dirty_area.next = tail;
-        return &self->dirty_area;
+        tail = &self->dirty_area;
+    }
+
+    if (self->rows_changed) {
+        for (uint16_t ty = 0; ty < self->height_in_tiles; ty++) {
+            displayio_area_t *row = &self->dirty_rows[ty];
+            if (displayio_area_empty(row)) {
+                continue;
+            }
+            _transform_dirty_area(self, row);
+            row->next = tail;
+            tail = row;
+        }
     }
     return tail;
 }
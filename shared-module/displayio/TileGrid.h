@@ -35,7 +35,11 @@ typedef struct {
     displayio_area_t dirty_area; // Stored as a relative area until the refresh area is fetched.
     displayio_area_t previous_area; // Stored as an absolute area.
     displayio_area_t current_area; // Stored as an absolute area so it applies across frames.
+    // One dirty area per on-screen row of tiles, relative like dirty_area. NULL when
+    // changed tiles are tracked by dirty_area alone.
+    displayio_area_t *dirty_rows;
     bool partial_change : 1;
+    bool rows_changed : 1;
     bool full_change : 1;
     bool moved : 1;
     bool inline_tiles : 1;
@@ -46,7 +50,7 @@ typedef struct {
     bool hidden : 1;
     bool hidden_by_parent : 1;
     bool rendered_hidden : 1;
-    uint8_t padding : 6;
+    uint8_t padding : 5;
 } displayio_tilegrid_t;
 
 void displayio_tilegrid_set_hidden_by_parent(displayio_tilegrid_t *self, bool hidden);
@@ -70,3 +74,6 @@ bool displayio_tilegrid_get_rendered_hidden(displayio_tilegrid_t *self);
 void displayio_tilegrid_validate_pixel_shader(mp_obj_t pixel_shader);
 
 void displayio_tilegrid_mark_tile_dirty(displayio_tilegrid_t *self, uint16_t x, uint16_t y);
+
+// Use the given storage, one area per row of tiles, to track changed tiles row by row.
+void displayio_tilegrid_set_dirty_rows(displayio_tilegrid_t *self, displayio_area_t *dirty_rows);
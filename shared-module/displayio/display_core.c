@@ -176,6 +176,63 @@ bool displayio_display_core_fill_area(displayio_display_core_t *self, displayio_
     return false;
 }
 
+// How many more pixels get sent if a and b are refreshed as their union rather
+// than separately. Negative when the union is cheaper.
+static int32_t _union_cost(const displayio_area_t *a, const displayio_area_t *b, displayio_area_t *u) {
+    displayio_area_union(a, b, u);
+    return (int32_t)displayio_area_size(u) - (int32_t)displayio_area_size(a) - (int32_t)displayio_area_size(b) - CIRCUITPY_DISPLAY_AREA_OVERHEAD_PIXELS;
+}
+
+const displayio_area_t *displayio_display_core_coalesce_areas(displayio_display_core_t *self, const displayio_area_t *areas) {
+    displayio_area_t *damage = self->damage;
+    size_t count = 0;
+    for (const displayio_area_t *area = areas; area != NULL; area = area->next) {
+        displayio_area_t pending;
+        if (!displayio_area_compute_overlap(&self->area, area, &pending)) {
+            continue;
+        }
+        // Merge with any rectangle where it pays off. The union may now pay
+        // off against other rectangles so start over after each merge.
+        size_t i = 0;
+        while (i < count) {
+            displayio_area_t u;
+            if (_union_cost(&damage[i], &pending, &u) <= 0) {
+                displayio_area_copy(&u, &pending);
+                count--;
+                displayio_area_copy(&damage[count], &damage[i]);
+                i = 0;
+            } else {
+                i++;
+            }
+        }
+        if (count == CIRCUITPY_DISPLAY_DAMAGE_AREAS) {
+            // Out of space so merge into the rectangle that grows the least.
+            size_t best = 0;
+            int32_t best_cost = INT32_MAX;
+            for (i = 0; i < count; i++) {
+                displayio_area_t u;
+                int32_t cost = _union_cost(&damage[i], &pending, &u);
+                if (cost < best_cost) {
+                    best_cost = cost;
+                    best = i;
+                }
+            }
+            displayio_area_union(&damage[best], &pending, &damage[best]);
+            continue;
+        }
+        displayio_area_copy(&pending, &damage[count]);
+        count++;
+    }
+    if (count == 0) {
+        return NULL;
+    }
+    for (size_t i = 0; i < count - 1; i++) {
+        damage[i].next = &damage[i + 1];
+    }
+    damage[count - 1].next = NULL;
+    return damage;
+}
+
 bool displayio_display_core_clip_area(displayio_display_core_t *self, const displayio_area_t *area, displayio_area_t *clipped) {
     bool overlaps = displayio_area_compute_overlap(&self->area, area, clipped);
     if (!overlaps) {
@@ -18,6 +18,7 @@ typedef struct {
     uint64_t last_refresh;
     displayio_buffer_transform_t transform;
     displayio_area_t area;
+    displayio_area_t damage[CIRCUITPY_DISPLAY_DAMAGE_AREAS];
     uint16_t width;
     uint16_t height;
     uint16_t rotation;
@@ -50,4 +51,9 @@ void displayio_display_core_collect_ptrs(displayio_display_core_t *self);
 
 bool displayio_display_core_fill_area(displayio_display_core_t *self, displayio_area_t *area, uint32_t *mask, uint32_t *buffer);
 
+// Merges the given linked list of dirty areas into at most
+// CIRCUITPY_DISPLAY_DAMAGE_AREAS rectangles clipped to the display. The result
+// is stored in the core and is valid until the next call.
+const displayio_area_t *displayio_display_core_coalesce_areas(displayio_display_core_t *self, const displayio_area_t *areas);
+
 bool displayio_display_core_clip_area(displayio_display_core_t *self, const displayio_area_t *area, displayio_area_t *clipped);
@@ -119,7 +119,7 @@ static const displayio_area_t *epaperdisplay_epaperdisplay_get_refresh_areas(epa
         self->core.area.next = NULL;
         return &self->core.area;
     }
-    return first_area;
+    return displayio_display_core_coalesce_areas(&self->core, first_area);
 }
 
 uint16_t common_hal_epaperdisplay_epaperdisplay_get_width(epaperdisplay_epaperdisplay_obj_t *self) {
@@ -110,7 +110,8 @@ static const displayio_area_t *_get_refresh_areas(framebufferio_framebufferdispl
         self->core.area.next = NULL;
         return &self->core.area;
     } else if (self->core.current_group != NULL) {
-        return displayio_group_get_refresh_areas(self->core.current_group, NULL);
+        const displayio_area_t *areas = displayio_group_get_refresh_areas(self->core.current_group, NULL);
+        return displayio_display_core_coalesce_areas(&self->core, areas);
     }
     return NULL;
 }
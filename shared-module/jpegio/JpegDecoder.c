@@ -5,6 +5,7 @@
 // SPDX-License-Identifier: MIT
 
 #include "py/runtime.h"
+#include "shared/runtime/interrupt_char.h"
 
 #include "shared-bindings/jpegio/JpegDecoder.h"
 #include "shared-bindings/bitmaptools/__init__.h"
@@ -54,6 +55,7 @@ static void check_jresult(JRESULT j) {
 
 void common_hal_jpegio_jpegdecoder_construct(jpegio_jpegdecoder_obj_t *self) {
     self->data_obj = MP_OBJ_NULL;
+    self->run_background_tasks = false;
 }
 
 void common_hal_jpegio_jpegdecoder_close(jpegio_jpegdecoder_obj_t *self) {
@@ -61,12 +63,16 @@ void common_hal_jpegio_jpegdecoder_close(jpegio_jpegdecoder_obj_t *self) {
     memset(&self->bufinfo, 0, sizeof(self->bufinfo));
 }
 
-static mp_obj_t common_hal_jpegio_jpegdecoder_decode_common(jpegio_jpegdecoder_obj_t *self, input_func fun) {
+static void jpegio_jpegdecoder_prepare(jpegio_jpegdecoder_obj_t *self, input_func fun) {
     JRESULT result = jd_prepare(&self->decoder, fun, &self->workspace, sizeof(self->workspace), NULL);
     if (result != JDR_OK) {
         common_hal_jpegio_jpegdecoder_close(self);
     }
     check_jresult(result);
+}
+
+static mp_obj_t common_hal_jpegio_jpegdecoder_decode_common(jpegio_jpegdecoder_obj_t *self, input_func fun) {
+    jpegio_jpegdecoder_prepare(self, fun);
     mp_obj_t elems[] = {
         MP_OBJ_NEW_SMALL_INT(self->decoder.width),
         MP_OBJ_NEW_SMALL_INT(self->decoder.height)
@@ -123,6 +129,14 @@ mp_obj_t common_hal_jpegio_jpegdecoder_set_source_buffer(jpegio_jpegdecoder_obj_
     return common_hal_jpegio_jpegdecoder_decode_common(self, buffer_input);
 }
 
+void jpegio_jpegdecoder_prepare_memory(jpegio_jpegdecoder_obj_t *self, const uint8_t *data, size_t len) {
+    // There's no object owning the data, but decode_into needs a source to be set.
+    self->data_obj = mp_const_none;
+    self->bufinfo.buf = (void *)data;
+    self->bufinfo.len = len;
+    jpegio_jpegdecoder_prepare(self, buffer_input);
+}
+
 #define DECODER_CONTINUE (1)
 #define DECODER_INTERRUPT (0)
 static int bitmap_output(JDEC *jd, void *data, JRECT *rect) {
@@ -182,6 +196,13 @@ static int bitmap_output(JDEC *jd, void *data, JRECT *rect) {
     assert(y2 <= src_height);
 
     common_hal_bitmaptools_blit(self->dest, &src, x, y, x1, y1, x2, y2, self->skip_source_index, self->skip_source_index_none, self->skip_dest_index, self->skip_dest_index_none);
+
+    if (self->run_background_tasks) {
+        RUN_BACKGROUND_TASKS;
+        if (mp_hal_is_interrupted()) {
+            return DECODER_INTERRUPT;
+        }
+    }
     return 1;
 }
 
@@ -23,5 +23,10 @@ typedef struct jpegio_jpegdecoder_obj {
     bitmaptools_rect_t lim;
     uint32_t skip_source_index, skip_dest_index;
     bool skip_source_index_none, skip_dest_index_none;
+    // Run background tasks while decoding so displays can refresh meanwhile.
+    bool run_background_tasks;
     uint8_t scale;
 } jpegio_jpegdecoder_obj_t;
+
+// Prepare to decode JPEG data in memory that the caller keeps alive until decode_into.
+void jpegio_jpegdecoder_prepare_memory(jpegio_jpegdecoder_obj_t *self, const uint8_t *data, size_t len);
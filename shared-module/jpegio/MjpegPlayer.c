@@ -0,0 +1,354 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include <string.h>
+
+#include "py/mphal.h"
+#include "py/runtime.h"
+#include "py/stream.h"
+
+#include "shared-bindings/jpegio/JpegDecoder.h"
+#include "shared-bindings/jpegio/MjpegPlayer.h"
+#include "shared-module/jpegio/MjpegPlayer.h"
+
+// JPEG markers without a length field.
+#define MARKER_SOI (0xd8)
+#define MARKER_EOI (0xd9)
+#define MARKER_SOS (0xda)
+#define MARKER_TEM (0x01)
+#define MARKER_IS_RST(m) ((m) >= 0xd0 && (m) <= 0xd7)
+
+// Reads more data after what's already buffered, discarding the buffer first if it has all been consumed.
+static void fill_input(jpegio_mjpegplayer_obj_t *self) {
+    if (self->input_pos == self->input_len) {
+        self->input_pos = 0;
+        self->input_len = 0;
+    }
+    int errcode = 0;
+    mp_uint_t len = mp_stream_rw(self->stream, self->input + self->input_len, sizeof(self->input) - self->input_len, &errcode, MP_STREAM_RW_READ | MP_STREAM_RW_ONCE);
+    if (errcode != 0) {
+        mp_raise_OSError(errcode);
+    }
+    self->input_len += len;
+    if (len == 0) {
+        self->eof = true;
+    }
+}
+
+// Copies (or skips, when dest is NULL) up to len bytes. Returns how many were available.
+static size_t read_input(jpegio_mjpegplayer_obj_t *self, uint8_t *dest, size_t len) {
+    size_t total = 0;
+    while (total < len) {
+        if (self->input_pos == self->input_len) {
+            if (self->eof) {
+                break;
+            }
+            fill_input(self);
+            continue;
+        }
+        size_t n = MIN(len - total, (size_t)(self->input_len - self->input_pos));
+        if (dest != NULL) {
+            memcpy(dest + total, self->input + self->input_pos, n);
+        }
+        self->input_pos += n;
+        total += n;
+    }
+    return total;
+}
+
+static int read_byte(jpegio_mjpegplayer_obj_t *self) {
+    uint8_t b;
+    if (read_input(self, &b, 1) != 1) {
+        return -1;
+    }
+    return b;
+}
+
+static uint8_t *reserve_frame(jpegio_mjpegplayer_obj_t *self, size_t len) {
+    size_t needed = self->frame_len + len;
+    if (needed > self->frame_alloc) {
+        size_t new_alloc = needed + needed / 4;
+        self->frame = m_renew(uint8_t, self->frame, self->frame_alloc, new_alloc);
+        self->frame_alloc = new_alloc;
+    }
+    uint8_t *result = self->frame + self->frame_len;
+    self->frame_len = needed;
+    return result;
+}
+
+static void append_frame(jpegio_mjpegplayer_obj_t *self, bool keep, const uint8_t *data, size_t len) {
+    if (keep) {
+        memcpy(reserve_frame(self, len), data, len);
+    }
+}
+
+static bool copy_input(jpegio_mjpegplayer_obj_t *self, bool keep, size_t len) {
+    uint8_t *dest = keep ? reserve_frame(self, len) : NULL;
+    return read_input(self, dest, len) == len;
+}
+
+// Reads one JPEG from a stream of concatenated JPEGs by walking its marker
+// segments. Scanning for an end of image marker alone would be fooled by
+// thumbnails embedded in APPn segments.
+static bool read_jpeg_frame(jpegio_mjpegplayer_obj_t *self, bool keep) {
+    // Find the start of image, tolerating padding between frames.
+    int previous = -1;
+    while (true) {
+        int c = read_byte(self);
+        if (c < 0) {
+            return false;
+        }
+        if (previous == 0xff && c == MARKER_SOI) {
+            break;
+        }
+        previous = c;
+    }
+    static const uint8_t soi[] = { 0xff, MARKER_SOI };
+    append_frame(self, keep, soi, sizeof(soi));
+
+    int marker = -1;
+    while (true) {
+        if (marker < 0) {
+            int c = read_byte(self);
+            if (c < 0) {
+                return false;
+            }
+            if (c != 0xff) {
+                mp_raise_RuntimeError(MP_ERROR_TEXT("Data format error (may be broken data)"));
+            }
+            // Any number of 0xff fill bytes may precede a marker.
+            do {
+                marker = read_byte(self);
+            } while (marker == 0xff);
+            if (marker < 0) {
+                return false;
+            }
+        }
+        uint8_t marker_bytes[] = { 0xff, marker };
+        append_frame(self, keep, marker_bytes, sizeof(marker_bytes));
+        if (marker == MARKER_EOI) {
+            return true;
+        }
+        bool has_length = marker != MARKER_TEM && !MARKER_IS_RST(marker);
+        bool scan = marker == MARKER_SOS;
+        marker = -1;
+        if (!has_length) {
+            continue;
+        }
+
+        uint8_t length_bytes[2];
+        if (read_input(self, length_bytes, 2) != 2) {
+            return false;
+        }
+        append_frame(self, keep, length_bytes, 2);
+        size_t length = length_bytes[0] << 8 | length_bytes[1];
+        if (length < 2 || !copy_input(self, keep, length - 2)) {
+            return false;
+        }
+        if (!scan) {
+            continue;
+        }
+
+        // Entropy coded data follows the scan header until the next marker.
+        // A 0xff in the data is followed by 0x00 (stuffing) or a restart marker.
+        while (marker < 0) {
+            if (self->input_pos == self->input_len) {
+                if (self->eof) {
+                    return false;
+                }
+                fill_input(self);
+                continue;
+            }
+            const uint8_t *start = self->input + self->input_pos;
+            size_t available = self->input_len - self->input_pos;
+            const uint8_t *ff = memchr(start, 0xff, available);
+            size_t run = ff == NULL ? available : (size_t)(ff - start);
+            append_frame(self, keep, start, run);
+            self->input_pos += run;
+            if (ff == NULL) {
+                continue;
+            }
+            self->input_pos++;
+            int next;
+            do {
+                next = read_byte(self);
+            } while (next == 0xff);
+            if (next < 0) {
+                return false;
+            }
+            if (next == 0 || MARKER_IS_RST(next)) {
+                uint8_t data[] = { 0xff, next };
+                append_frame(self, keep, data, sizeof(data));
+            } else {
+                marker = next;
+            }
+        }
+    }
+}
+
+// Reads the next '##dc' or '##db' chunk of an AVI file, descending into the
+// 'movi' list and skipping everything else.
+static bool read_avi_frame(jpegio_mjpegplayer_obj_t *self, bool keep) {
+    while (true) {
+        uint8_t header[8];
+        if (read_input(self, header, sizeof(header)) != sizeof(header)) {
+            return false;
+        }
+        uint32_t size = header[4] | header[5] << 8 | header[6] << 16 | (uint32_t)header[7] << 24;
+        if (memcmp(header, "LIST", 4) == 0) {
+            uint8_t list_type[4];
+            if (size < 4 || read_input(self, list_type, sizeof(list_type)) != sizeof(list_type)) {
+                return false;
+            }
+            if (memcmp(list_type, "movi", 4) == 0 || memcmp(list_type, "rec ", 4) == 0) {
+                continue;
+            }
+            size -= 4;
+        } else if (header[2] == 'd' && (header[3] == 'c' || header[3] == 'b') && size > 0) {
+            if (!copy_input(self, keep, size)) {
+                return false;
+            }
+            // Chunks are padded to an even length.
+            return read_input(self, NULL, size & 1) == (size & 1);
+        }
+        size_t padded = size + (size & 1);
+        if (read_input(self, NULL, padded) != padded) {
+            return false;
+        }
+    }
+}
+
+// Reads the next frame into self->frame, or just skips over it. Returns false
+// at the end of the stream.
+static bool read_frame(jpegio_mjpegplayer_obj_t *self, bool keep) {
+    // The decoder may still point at the old frame, which is about to be overwritten.
+    common_hal_jpegio_jpegdecoder_close(&self->decoder);
+    self->frame_len = 0;
+    bool ok = self->avi ? read_avi_frame(self, keep) : read_jpeg_frame(self, keep);
+    if (!ok || !keep) {
+        self->frame_len = 0;
+    }
+    return ok;
+}
+
+void common_hal_jpegio_mjpegplayer_construct(jpegio_mjpegplayer_obj_t *self, mp_obj_t stream, mp_float_t fps, int scale) {
+    self->stream = stream;
+    common_hal_jpegio_jpegdecoder_construct(&self->decoder);
+    self->decoder.base.type = &jpegio_jpegdecoder_type;
+    self->decoder.run_background_tasks = true;
+    self->frame = NULL;
+    self->frame_len = 0;
+    self->frame_alloc = 0;
+    self->input_pos = 0;
+    self->input_len = 0;
+    self->eof = false;
+    self->started = false;
+    self->frames_decoded = 0;
+    self->frames_dropped = 0;
+    self->frame_ms = fps > 0 ? (uint32_t)(1000 / fps) : 0;
+    self->scale = scale;
+
+    // Buffer enough to identify the container without consuming anything.
+    const size_t header_len = 12;
+    while (self->input_len < header_len && !self->eof) {
+        fill_input(self);
+    }
+    const uint8_t *header = self->input;
+    self->avi = self->input_len >= header_len && memcmp(header, "RIFF", 4) == 0 && memcmp(header + 8, "AVI ", 4) == 0;
+    if (self->avi) {
+        self->input_pos = header_len;
+    } else if (self->input_len < 2 || header[0] != 0xff || header[1] != MARKER_SOI) {
+        mp_raise_ValueError(MP_ERROR_TEXT("Format not supported"));
+    }
+
+    // Read the first frame now to learn the video size.
+    if (!read_frame(self, true)) {
+        mp_raise_RuntimeError(MP_ERROR_TEXT("Data format error (may be broken data)"));
+    }
+    jpegio_jpegdecoder_prepare_memory(&self->decoder, self->frame, self->frame_len);
+    self->width = self->decoder.decoder.width;
+    self->height = self->decoder.decoder.height;
+}
+
+void common_hal_jpegio_mjpegplayer_deinit(jpegio_mjpegplayer_obj_t *self) {
+    if (common_hal_jpegio_mjpegplayer_deinited(self)) {
+        return;
+    }
+    common_hal_jpegio_jpegdecoder_close(&self->decoder);
+    m_del(uint8_t, self->frame, self->frame_alloc);
+    self->frame = NULL;
+    self->frame_len = 0;
+    self->frame_alloc = 0;
+    self->stream = MP_OBJ_NULL;
+}
+
+bool common_hal_jpegio_mjpegplayer_deinited(jpegio_mjpegplayer_obj_t *self) {
+    return self->stream == MP_OBJ_NULL;
+}
+
+uint16_t common_hal_jpegio_mjpegplayer_get_width(jpegio_mjpegplayer_obj_t *self) {
+    return self->width;
+}
+
+uint16_t common_hal_jpegio_mjpegplayer_get_height(jpegio_mjpegplayer_obj_t *self) {
+    return self->height;
+}
+
+uint32_t common_hal_jpegio_mjpegplayer_get_frames_decoded(jpegio_mjpegplayer_obj_t *self) {
+    return self->frames_decoded;
+}
+
+uint32_t common_hal_jpegio_mjpegplayer_get_frames_dropped(jpegio_mjpegplayer_obj_t *self) {
+    return self->frames_dropped;
+}
+
+bool common_hal_jpegio_mjpegplayer_next_frame(jpegio_mjpegplayer_obj_t *self, displayio_bitmap_t *bitmap, int16_t x, int16_t y) {
+    if (self->frame_len == 0) {
+        return false;
+    }
+
+    if (self->frame_ms != 0 && self->started) {
+        // Drop frames we're already too late to show, without decoding them.
+        uint32_t late = (uint32_t)(mp_hal_ticks_ms() - self->next_frame_ticks);
+        if ((int32_t)late >= (int32_t)self->frame_ms) {
+            uint32_t drop = late / self->frame_ms;
+            self->next_frame_ticks += drop * self->frame_ms;
+            self->frames_dropped += drop;
+            bool ok = true;
+            for (uint32_t i = 1; ok && i < drop; i++) {
+                ok = read_frame(self, false);
+            }
+            if (!ok || !read_frame(self, true)) {
+                return false;
+            }
+        }
+    }
+
+    if (self->decoder.data_obj == MP_OBJ_NULL) {
+        jpegio_jpegdecoder_prepare_memory(&self->decoder, self->frame, self->frame_len);
+    }
+    bitmaptools_rect_t lim = { .x1 = 0, .y1 = 0, .x2 = bitmap->width, .y2 = bitmap->height };
+    // Background tasks run while decoding so a display can be sending the
+    // previously returned bitmap at the same time.
+    common_hal_jpegio_jpegdecoder_decode_into(&self->decoder, bitmap, self->scale, x, y, &lim, 0, true, 0, true);
+    self->frames_decoded++;
+
+    // Read the next frame ahead while its data is needed anyway.
+    read_frame(self, true);
+
+    if (self->frame_ms != 0) {
+        if (!self->started) {
+            self->next_frame_ticks = mp_hal_ticks_ms();
+            self->started = true;
+        }
+        int32_t wait = (int32_t)(self->next_frame_ticks - mp_hal_ticks_ms());
+        if (wait > 0) {
+            mp_hal_delay_ms(wait);
+        }
+        self->next_frame_ticks += self->frame_ms;
+    }
+    return true;
+}
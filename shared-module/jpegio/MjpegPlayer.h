@@ -0,0 +1,37 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "py/obj.h"
+#include "shared-bindings/jpegio/JpegDecoder.h"
+#include "shared-module/jpegio/JpegDecoder.h"
+
+#define MJPEG_INPUT_BUFFER_SIZE (512)
+
+typedef struct jpegio_mjpegplayer_obj {
+    mp_obj_base_t base;
+    jpegio_jpegdecoder_obj_t decoder;
+    mp_obj_t stream;
+    // Compressed data of the next frame, read ahead of decoding.
+    uint8_t *frame;
+    size_t frame_len;
+    size_t frame_alloc;
+    // Buffered reads from the stream so markers can be scanned cheaply.
+    uint8_t input[MJPEG_INPUT_BUFFER_SIZE];
+    uint16_t input_pos;
+    uint16_t input_len;
+    uint32_t frame_ms;
+    uint32_t next_frame_ticks;
+    uint32_t frames_decoded;
+    uint32_t frames_dropped;
+    uint16_t width;
+    uint16_t height;
+    uint8_t scale;
+    bool avi;
+    bool eof;
+    bool started;
+} jpegio_mjpegplayer_obj_t;
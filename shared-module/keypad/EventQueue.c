@@ -8,6 +8,7 @@
 #include "shared-bindings/keypad/EventQueue.h"
 #include "shared-bindings/supervisor/__init__.h"
 #include "shared-module/keypad/EventQueue.h"
+#include "py/stream.h"
 
 // Key number is lower 15 bits of a 16-bit value.
 #define EVENT_PRESSED (1 << 15)
@@ -91,6 +92,9 @@ bool keypad_eventqueue_record(keypad_eventqueue_obj_t *self, mp_uint_t key_numbe
     ringbuf_put16(&self->encoded_events, encoded_event);
     ringbuf_put_n(&self->encoded_events, (uint8_t *)&timestamp, sizeof(mp_obj_t));
 
+    // Tell select.poll there is an event to get.
+    mp_stream_poll_notify(MP_OBJ_FROM_PTR(self));
+
     if (self->event_handler) {
         self->event_handler(self);
     }
@@ -8,6 +8,7 @@
 #include "py/obj.h"
 #include "py/mphal.h"
 #include "py/runtime.h"
+#include "py/stream.h"
 #include "py/objtuple.h"
 #include "shared-bindings/usb_cdc/__init__.h"
 #include "shared-bindings/usb_cdc/Serial.h"
@@ -161,6 +162,16 @@ bool usb_cdc_data_enabled(void) {
     return usb_cdc_data_is_enabled;
 }
 
+// Tell select.poll that the Serial object on CDC interface itf may have become
+// readable or writable. Called from TinyUSB callbacks.
+void usb_cdc_poll_notify(uint8_t itf) {
+    if (usb_cdc_console_is_enabled && usb_cdc_console_obj.idx == itf) {
+        mp_stream_poll_notify(MP_OBJ_FROM_PTR(&usb_cdc_console_obj));
+    } else if (usb_cdc_data_is_enabled && usb_cdc_data_obj.idx == itf) {
+        mp_stream_poll_notify(MP_OBJ_FROM_PTR(&usb_cdc_data_obj));
+    }
+}
+
 size_t usb_cdc_descriptor_length(void) {
     return sizeof(usb_cdc_descriptor_template);
 }
@@ -14,6 +14,7 @@ bool usb_cdc_console_enabled(void);
 bool usb_cdc_data_enabled(void);
 
 void usb_cdc_set_defaults(void);
+void usb_cdc_poll_notify(uint8_t itf);
 
 size_t usb_cdc_descriptor_length(void);
 size_t usb_cdc_add_descriptor(uint8_t *descriptor_buf, descriptor_counts_t *descriptor_counts, uint8_t *current_interface_string, bool console);
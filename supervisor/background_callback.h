@@ -7,6 +7,8 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
 /** Background callbacks are a linked list of tasks to call in the background.
  *
@@ -34,13 +36,41 @@
  * which includes port_background_tick(), every millisecond.
  */
 typedef void (*background_callback_fun)(void *data);
+
+/** Each time background tasks run, queued callbacks run in priority order, and
+ * callbacks queued in the meantime with a higher priority than the next one
+ * due to run get to go first. Zero-initialized callbacks get
+ * BACKGROUND_CALLBACK_PRIORITY_NORMAL, which runs after audio and USB and
+ * before display refresh and filesystem flushes.
+ */
+typedef enum {
+    BACKGROUND_CALLBACK_PRIORITY_NORMAL,
+    BACKGROUND_CALLBACK_PRIORITY_AUDIO,
+    BACKGROUND_CALLBACK_PRIORITY_USB,
+    BACKGROUND_CALLBACK_PRIORITY_DISPLAY,
+    BACKGROUND_CALLBACK_PRIORITY_FILESYSTEM,
+    BACKGROUND_CALLBACK_PRIORITY_COUNT,
+} background_callback_priority_t;
+
 typedef struct background_callback {
     background_callback_fun fun;
     void *data;
     struct background_callback *next;
     struct background_callback *prev;
+    // A background_callback_priority_t. Only change it while not queued.
+    uint8_t priority;
+    // If not zero, runs taking longer than this are counted as overruns in
+    // the background callback stats.
+    uint16_t budget_us;
 } background_callback_t;
 
+// Time budgets for the callbacks that must not hold up the others. Audio has
+// to refill a buffer before the DMA reaches the end of the other one, which
+// is about 1 ms with the smallest buffers at 44.1 kHz. A display refresh
+// should fit in a 60 Hz frame.
+#define BACKGROUND_CALLBACK_AUDIO_BUDGET_US (1000)
+#define BACKGROUND_CALLBACK_DISPLAY_BUDGET_US (16666)
+
 /* Add a background callback for which 'fun' and 'data' were previously set */
 void background_callback_add_core(background_callback_t *cb);
 
@@ -53,6 +83,9 @@ void background_callback_add_core(background_callback_t *cb);
  */
 void background_callback_add(background_callback_t *cb, background_callback_fun fun, void *data);
 
+/* Like background_callback_add, also setting the callback's priority. */
+void background_callback_add_with_priority(background_callback_t *cb, background_callback_fun fun, void *data, background_callback_priority_t priority);
+
 /* Run all background callbacks.  Normally, this is done by the supervisor
  * whenever the list is non-empty */
 void background_callback_run_all(void);
@@ -75,3 +108,23 @@ void background_callback_allow(void);
  * Background callbacks may stop objects from being collected
  */
 void background_callback_gc_collect(void);
+
+#if CIRCUITPY_BACKGROUND_CALLBACK_STATS
+// The number of callback functions that stats are kept for.
+#define BACKGROUND_CALLBACK_MAX_STATS (16)
+
+// Time spent in the callbacks to one function.
+typedef struct {
+    background_callback_fun fun;
+    uint8_t priority;
+    uint32_t runs;
+    uint32_t overruns;
+    uint32_t max_us;
+    uint64_t total_us;
+} background_callback_stats_t;
+
+/* Copy out the stats of up to max_stats callback functions, in the order they
+ * first ran, and return how many were copied. */
+size_t background_callback_get_stats(background_callback_stats_t *stats, size_t max_stats);
+void background_callback_reset_stats(void);
+#endif
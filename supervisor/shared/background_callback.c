@@ -7,6 +7,7 @@
 #include <string.h>
 
 #include "py/gc.h"
+#include "py/misc.h"
 #include "py/mpconfig.h"
 #include "supervisor/background_callback.h"
 #include "supervisor/linker.h"
@@ -14,7 +15,32 @@
 #include "supervisor/shared/tick.h"
 #include "shared-bindings/microcontroller/__init__.h"
 
-static volatile background_callback_t *volatile callback_head, *volatile callback_tail;
+// One queue per priority, in the order they run.
+typedef struct {
+    volatile background_callback_t *volatile head;
+    volatile background_callback_t *volatile tail;
+} callback_queue_t;
+
+static callback_queue_t callback_queues[BACKGROUND_CALLBACK_PRIORITY_COUNT];
+
+// Queue used for each priority.
+static const uint8_t queue_for_priority[BACKGROUND_CALLBACK_PRIORITY_COUNT] = {
+    [BACKGROUND_CALLBACK_PRIORITY_AUDIO] = 0,
+    [BACKGROUND_CALLBACK_PRIORITY_USB] = 1,
+    [BACKGROUND_CALLBACK_PRIORITY_NORMAL] = 2,
+    [BACKGROUND_CALLBACK_PRIORITY_DISPLAY] = 3,
+    [BACKGROUND_CALLBACK_PRIORITY_FILESYSTEM] = 4,
+};
+
+static inline callback_queue_t *queue_for(background_callback_t *cb) {
+    return &callback_queues[queue_for_priority[cb->priority]];
+}
+
+// Set when a callback is queued, so the VM hook knows to run background tasks.
+volatile uint8_t background_callback_queued;
+// Backwards jumps and returns left before the VM hook runs background tasks
+// anyway.
+uint8_t background_callback_vm_hook_countdown = CIRCUITPY_BACKGROUND_VM_HOOK_INTERVAL;
 
 #ifndef CALLBACK_CRITICAL_BEGIN
 #define CALLBACK_CRITICAL_BEGIN (common_hal_mcu_disable_interrupts())
@@ -28,19 +54,21 @@ MP_WEAK void PLACE_IN_ITCM(port_wake_main_task)(void) {
 
 void PLACE_IN_ITCM(background_callback_add_core)(background_callback_t * cb) {
     CALLBACK_CRITICAL_BEGIN;
-    if (cb->prev || callback_head == cb) {
+    callback_queue_t *queue = queue_for(cb);
+    if (cb->prev || queue->head == cb) {
         CALLBACK_CRITICAL_END;
         return;
     }
     cb->next = 0;
-    cb->prev = (background_callback_t *)callback_tail;
-    if (callback_tail) {
-        callback_tail->next = cb;
+    cb->prev = (background_callback_t *)queue->tail;
+    if (queue->tail) {
+        queue->tail->next = cb;
     }
-    if (!callback_head) {
-        callback_head = cb;
+    if (!queue->head) {
+        queue->head = cb;
     }
-    callback_tail = cb;
+    queue->tail = cb;
+    background_callback_queued = 1;
     CALLBACK_CRITICAL_END;
 
     port_wake_main_task();
@@ -52,14 +80,89 @@ void PLACE_IN_ITCM(background_callback_add)(background_callback_t * cb, backgrou
     background_callback_add_core(cb);
 }
 
+void PLACE_IN_ITCM(background_callback_add_with_priority)(background_callback_t * cb, background_callback_fun fun, void *data, background_callback_priority_t priority) {
+    CALLBACK_CRITICAL_BEGIN;
+    // The priority picks the queue, so leave it alone while the callback is
+    // queued.
+    if (!cb->prev && queue_for(cb)->head != cb) {
+        cb->priority = priority;
+    }
+    CALLBACK_CRITICAL_END;
+    background_callback_add(cb, fun, data);
+}
+
 inline bool background_callback_pending(void) {
-    return callback_head != NULL;
+    for (size_t i = 0; i < BACKGROUND_CALLBACK_PRIORITY_COUNT; i++) {
+        if (callback_queues[i].head != NULL) {
+            return true;
+        }
+    }
+    return false;
+}
+
+#if CIRCUITPY_BACKGROUND_CALLBACK_STATS
+static background_callback_stats_t callback_stats[BACKGROUND_CALLBACK_MAX_STATS];
+static size_t callback_stats_count;
+
+// Current time in units of 1/32768 seconds.
+static uint64_t stats_now(void) {
+    uint8_t subticks;
+    uint64_t ticks = port_get_raw_ticks(&subticks);
+    return (ticks << 5) | subticks;
+}
+
+static void record_stats(background_callback_fun fun, uint8_t priority, uint16_t budget_us, uint64_t start) {
+    uint32_t us = (uint32_t)((stats_now() - start) * 1000000 / 32768);
+    background_callback_stats_t *stats = NULL;
+    for (size_t i = 0; i < callback_stats_count; i++) {
+        if (callback_stats[i].fun == fun) {
+            stats = &callback_stats[i];
+            break;
+        }
+    }
+    if (stats == NULL) {
+        if (callback_stats_count == BACKGROUND_CALLBACK_MAX_STATS) {
+            return;
+        }
+        stats = &callback_stats[callback_stats_count++];
+        stats->fun = fun;
+    }
+    stats->priority = priority;
+    stats->runs++;
+    stats->total_us += us;
+    if (us > stats->max_us) {
+        stats->max_us = us;
+    }
+    if (budget_us != 0 && us > budget_us) {
+        stats->overruns++;
+    }
+}
+
+size_t background_callback_get_stats(background_callback_stats_t *stats, size_t max_stats) {
+    CALLBACK_CRITICAL_BEGIN;
+    size_t count = MIN(max_stats, callback_stats_count);
+    memcpy(stats, callback_stats, count * sizeof(background_callback_stats_t));
+    CALLBACK_CRITICAL_END;
+    return count;
 }
 
+void background_callback_reset_stats(void) {
+    CALLBACK_CRITICAL_BEGIN;
+    callback_stats_count = 0;
+    memset(callback_stats, 0, sizeof(callback_stats));
+    CALLBACK_CRITICAL_END;
+}
+#endif
+
 static int background_prevention_count;
 
 void PLACE_IN_ITCM(background_callback_run_all)(void) {
     port_background_task();
+    background_callback_vm_hook_countdown = CIRCUITPY_BACKGROUND_VM_HOOK_INTERVAL;
+    // Clear before looking, so that a callback queued from now on sets it
+    // again. Callbacks left queued because running them is prevented wait for
+    // the countdown.
+    background_callback_queued = 0;
     if (!background_callback_pending()) {
         return;
     }
@@ -69,21 +172,65 @@ void PLACE_IN_ITCM(background_callback_run_all)(void) {
         return;
     }
     ++background_prevention_count;
-    background_callback_t *cb = (background_callback_t *)callback_head;
-    callback_head = NULL;
-    callback_tail = NULL;
-    while (cb) {
-        background_callback_t *next = cb->next;
+    // Run what is queued so far, up to the tail of each queue now. Callbacks
+    // queued while these run wait for the next call, unless they have a
+    // higher priority than the one that would run next. Callbacks are taken
+    // off the live queues one at a time, so that the ones waiting still look
+    // queued to background_callback_add and get marked by
+    // background_callback_gc_collect.
+    background_callback_t *last[BACKGROUND_CALLBACK_PRIORITY_COUNT];
+    for (size_t i = 0; i < BACKGROUND_CALLBACK_PRIORITY_COUNT; i++) {
+        last[i] = (background_callback_t *)callback_queues[i].tail;
+    }
+    size_t last_level = 0;
+    while (true) {
+        // Let newly queued callbacks jump ahead, but only from levels above
+        // the last one run, so that one requeueing itself can't starve the
+        // rest.
+        for (size_t i = 0; i < last_level; i++) {
+            if (last[i] == NULL && callback_queues[i].head != NULL) {
+                last[i] = (background_callback_t *)callback_queues[i].tail;
+            }
+        }
+        size_t level = 0;
+        while (level < BACKGROUND_CALLBACK_PRIORITY_COUNT &&
+               (last[level] == NULL || callback_queues[level].head == NULL)) {
+            last[level] = NULL;
+            level++;
+        }
+        if (level == BACKGROUND_CALLBACK_PRIORITY_COUNT) {
+            break;
+        }
+        callback_queue_t *queue = &callback_queues[level];
+        background_callback_t *cb = (background_callback_t *)queue->head;
+        queue->head = cb->next;
+        if (queue->head) {
+            queue->head->prev = NULL;
+        } else {
+            queue->tail = NULL;
+        }
+        if (cb == last[level]) {
+            last[level] = NULL;
+        }
+        last_level = level;
         cb->next = cb->prev = NULL;
         background_callback_fun fun = cb->fun;
         void *data = cb->data;
         CALLBACK_CRITICAL_END;
         // Leave the critical section in order to run the callback function
         if (fun) {
+            #if CIRCUITPY_BACKGROUND_CALLBACK_STATS
+            // The callback may free cb, so don't look at it afterwards.
+            uint8_t priority = cb->priority;
+            uint16_t budget_us = cb->budget_us;
+            uint64_t start = stats_now();
+            fun(data);
+            record_stats(fun, priority, budget_us, start);
+            #else
             fun(data);
+            #endif
         }
         CALLBACK_CRITICAL_BEGIN;
-        cb = next;
     }
     --background_prevention_count;
     CALLBACK_CRITICAL_END;
@@ -104,33 +251,35 @@ void background_callback_allow(void) {
 
 // Filter out queued callbacks if they are allocated on the heap.
 void background_callback_reset(void) {
-    background_callback_t *new_head = NULL;
-    background_callback_t **previous_next = &new_head;
-    background_callback_t *new_tail = NULL;
     CALLBACK_CRITICAL_BEGIN;
-    background_callback_t *cb = (background_callback_t *)callback_head;
-    while (cb) {
-        background_callback_t *next = cb->next;
-        cb->next = NULL;
-        // Unlink any callbacks that are allocated on the python heap or if they
-        // reference data on the python heap. The python heap will be disappear
-        // soon after this.
-        if (gc_ptr_on_heap((void *)cb) || gc_ptr_on_heap(cb->data)) {
-            cb->prev = NULL; // Used to indicate a callback isn't queued.
-        } else {
-            // Set .next of the previous callback.
-            *previous_next = cb;
-            // Set our .next for the next callback.
-            previous_next = &cb->next;
-            // Set our prev to the last callback.
-            cb->prev = new_tail;
-            // Now we're the tail of the list.
-            new_tail = cb;
+    for (size_t i = 0; i < BACKGROUND_CALLBACK_PRIORITY_COUNT; i++) {
+        background_callback_t *new_head = NULL;
+        background_callback_t **previous_next = &new_head;
+        background_callback_t *new_tail = NULL;
+        background_callback_t *cb = (background_callback_t *)callback_queues[i].head;
+        while (cb) {
+            background_callback_t *next = cb->next;
+            cb->next = NULL;
+            // Unlink any callbacks that are allocated on the python heap or if they
+            // reference data on the python heap. The python heap will be disappear
+            // soon after this.
+            if (gc_ptr_on_heap((void *)cb) || gc_ptr_on_heap(cb->data)) {
+                cb->prev = NULL; // Used to indicate a callback isn't queued.
+            } else {
+                // Set .next of the previous callback.
+                *previous_next = cb;
+                // Set our .next for the next callback.
+                previous_next = &cb->next;
+                // Set our prev to the last callback.
+                cb->prev = new_tail;
+                // Now we're the tail of the list.
+                new_tail = cb;
+            }
+            cb = next;
         }
-        cb = next;
+        callback_queues[i].head = new_head;
+        callback_queues[i].tail = new_tail;
     }
-    callback_head = new_head;
-    callback_tail = new_tail;
     background_prevention_count = 0;
     CALLBACK_CRITICAL_END;
 }
@@ -150,9 +299,11 @@ void background_callback_gc_collect(void) {
     // It's necessary to traverse the whole list here, as the callbacks
     // themselves can be in non-gc memory, and some of the cb->data
     // objects themselves might be in non-gc memory.
-    background_callback_t *cb = (background_callback_t *)callback_head;
-    while (cb) {
-        gc_collect_ptr(cb->data);
-        cb = cb->next;
+    for (size_t i = 0; i < BACKGROUND_CALLBACK_PRIORITY_COUNT; i++) {
+        background_callback_t *cb = (background_callback_t *)callback_queues[i].head;
+        while (cb) {
+            gc_collect_ptr(cb->data);
+            cb = cb->next;
+        }
     }
 }
@@ -284,16 +284,17 @@ void supervisor_start_terminal(uint16_t width_px, uint16_t height_px) {
 
     if (new_font != mp_const_none) {
         size_t total_values = common_hal_displayio_bitmap_get_width(new_bitmap) / glyph_width;
-        if (tilegrid_tiles) {
-            port_free(tilegrid_tiles);
-            tilegrid_tiles = NULL;
-        }
+        // Free the old tiles and clear every pointer into them so nothing is
+        // left dangling if the new allocation below fails.
+        supervisor_stop_terminal();
         size_t bytes_per_tile = 1;
         if (total_tiles > 255) {
             // Two bytes per tile.
             bytes_per_tile = 2;
         }
-        tilegrid_tiles = port_malloc(total_tiles * bytes_per_tile, false);
+        // The scroll area's per-row dirty areas follow the tiles, aligned for the area struct.
+        size_t tiles_size = (total_tiles * bytes_per_tile + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+        tilegrid_tiles = port_malloc(tiles_size + scroll_area->height_in_tiles * sizeof(displayio_area_t), false);
         if (!tilegrid_tiles) {
             return;
         }
@@ -303,6 +304,7 @@ void supervisor_start_terminal(uint16_t width_px, uint16_t height_px) {
         scroll_area->tiles = tilegrid_tiles + width_in_tiles * bytes_per_tile;
         scroll_area->tiles_in_bitmap = total_values;
         scroll_area->bitmap_width_in_tiles = total_values;
+        displayio_tilegrid_set_dirty_rows(scroll_area, (displayio_area_t *)(tilegrid_tiles + tiles_size));
 
         common_hal_displayio_tilegrid_set_bitmap(scroll_area, new_bitmap);
         common_hal_displayio_tilegrid_set_bitmap(status_bar, new_bitmap);
@@ -319,6 +321,7 @@ void supervisor_stop_terminal(void) {
         tilegrid_tiles = NULL;
         tilegrid_tiles_size = 0;
         supervisor_terminal_scroll_area_text_grid.tiles = NULL;
+        displayio_tilegrid_set_dirty_rows(&supervisor_terminal_scroll_area_text_grid, NULL);
         supervisor_terminal_status_bar_text_grid.tiles = NULL;
         supervisor_terminal.scroll_area = NULL;
         supervisor_terminal.status_bar = NULL;
@@ -10,6 +10,7 @@
 #include "genhdr/devices.h"
 #include "supervisor/flash.h"
 #include "supervisor/port.h"
+#include "supervisor/port_heap.h"
 #include "supervisor/spi_flash_api.h"
 #include "supervisor/shared/external_flash/common_commands.h"
 #include "extmod/vfs.h"
@@ -22,7 +23,8 @@
 
 #define NO_SECTOR_LOADED 0xFFFFFFFF
 
-// The currently cached sector in the cache, ram or flash based.
+// The sector cached in the scratch sector of flash. Only used when there is no
+// ram for a cache.
 static uint32_t current_sector;
 
 static const external_flash_device possible_devices[] = {EXTERNAL_FLASH_DEVICES};
@@ -31,15 +33,31 @@ static const external_flash_device possible_devices[] = {EXTERNAL_FLASH_DEVICES}
 static const external_flash_device *flash_device = NULL;
 
 // Track which blocks (up to 32) in the current sector currently live in the
-// cache.
+// scratch sector.
 static uint32_t dirty_mask;
 
-// Table of pointers to each cached block. Should be zero'd after allocation.
 #define BLOCKS_PER_SECTOR (SPI_FLASH_ERASE_SIZE / FILESYSTEM_BLOCK_SIZE)
 #define PAGES_PER_BLOCK (FILESYSTEM_BLOCK_SIZE / SPI_FLASH_PAGE_SIZE)
 #define FLASH_CACHE_TABLE_NUM_ENTRIES (BLOCKS_PER_SECTOR * PAGES_PER_BLOCK)
-#define FLASH_CACHE_TABLE_SIZE (FLASH_CACHE_TABLE_NUM_ENTRIES * sizeof (uint8_t *))
-static uint8_t **flash_cache_table = NULL;
+
+// A sector cached in ram. Each page is allocated separately so that the heap
+// doesn't need to provide one huge block.
+typedef struct {
+    // The cached sector, or NO_SECTOR_LOADED if the entry is free.
+    uint32_t sector;
+    // Track which blocks (up to 32) in the sector currently live in the cache.
+    uint32_t dirty_mask;
+    // Value of flash_cache_clock when the sector was last written.
+    uint32_t last_write;
+    uint8_t *pages[FLASH_CACHE_TABLE_NUM_ENTRIES];
+} flash_cache_t;
+
+// Sectors cached in ram, allocated as needed while there is memory for them.
+// Writes within these sectors, including rewrites of the same block, only touch
+// ram until the cache is flushed or the least recently written sector is needed
+// for another one.
+static flash_cache_t *flash_cache[CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS];
+static uint32_t flash_cache_clock;
 
 // Wait until both the write enable and write in progress bits have cleared.
 static bool wait_for_flash_ready(void) {
@@ -135,7 +153,7 @@ static bool page_erased(uint32_t sector_address) {
     uint8_t full_buffer[FILESYSTEM_BLOCK_SIZE];
     if (read_flash(sector_address, full_buffer, FILESYSTEM_BLOCK_SIZE)) {
         for (uint16_t i = 0; i < FILESYSTEM_BLOCK_SIZE; i++) {
-            if (short_buffer[i] != 0xff) {
+            if (full_buffer[i] != 0xff) {
                 return false;
             }
         }
@@ -283,7 +301,7 @@ void supervisor_flash_init(void) {
 
     current_sector = NO_SECTOR_LOADED;
     dirty_mask = 0;
-    flash_cache_table = NULL;
+    memset(flash_cache, 0, sizeof(flash_cache));
 }
 
 // The size of each individual block.
@@ -330,126 +348,161 @@ static bool flush_scratch_flash(void) {
         copy_block(scratch_sector + i * FILESYSTEM_BLOCK_SIZE,
             current_sector + i * FILESYSTEM_BLOCK_SIZE);
     }
+    current_sector = NO_SECTOR_LOADED;
     return true;
 }
 
-// Free all entries in the partially or completely filled flash_cache_table, and then free the table itself.
-static void release_ram_cache(void) {
-    if (flash_cache_table == NULL) {
-        return;
-    }
-
+// Free a cache entry and all of the pages it managed to allocate.
+static void release_cache_entry(flash_cache_t *cache) {
     for (size_t i = 0; i < FLASH_CACHE_TABLE_NUM_ENTRIES; i++) {
         // Table may not be completely full. Stop at first NULL entry.
-        if (flash_cache_table[i] == NULL) {
+        if (cache->pages[i] == NULL) {
             break;
         }
-        port_free(flash_cache_table[i]);
+        port_free(cache->pages[i]);
+    }
+    port_free(cache);
+}
+
+// Free the ram cache entries that have been flushed, except for the first keep
+// of them. Entries that still hold a sector failed to flush and are kept so
+// that their data isn't lost.
+static void release_ram_cache(size_t keep) {
+    for (size_t i = 0; i < CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS; i++) {
+        if (flash_cache[i] == NULL || flash_cache[i]->sector != NO_SECTOR_LOADED) {
+            continue;
+        }
+        if (keep > 0) {
+            keep--;
+            continue;
+        }
+        release_cache_entry(flash_cache[i]);
+        flash_cache[i] = NULL;
     }
-    port_free(flash_cache_table);
-    flash_cache_table = NULL;
 }
 
 // Attempts to allocate a new set of page buffers for caching a full sector in
-// ram. Each page is allocated separately so that the GC doesn't need to provide
-// one huge block. We can free it as we write if we want to also.
-static bool allocate_ram_cache(void) {
-    flash_cache_table = port_malloc(FLASH_CACHE_TABLE_SIZE, false);
-    if (flash_cache_table == NULL) {
+// ram. Returns NULL if there isn't enough memory.
+static flash_cache_t *allocate_cache_entry(void) {
+    flash_cache_t *cache = port_malloc(sizeof(flash_cache_t), false);
+    if (cache == NULL) {
         // Not enough space even for the cache table.
-        return false;
+        return NULL;
     }
 
     // Clear all the entries so it's easy to find the last entry.
-    memset(flash_cache_table, 0, FLASH_CACHE_TABLE_SIZE);
-
-    bool success = true;
-    for (size_t i = 0; i < BLOCKS_PER_SECTOR && success; i++) {
-        for (size_t j = 0; j < PAGES_PER_BLOCK && success; j++) {
-            uint8_t *page_cache = port_malloc(SPI_FLASH_PAGE_SIZE, false);
-            if (page_cache == NULL) {
-                success = false;
-                break;
-            }
-            flash_cache_table[i * PAGES_PER_BLOCK + j] = page_cache;
-        }
-    }
+    memset(cache, 0, sizeof(flash_cache_t));
+    cache->sector = NO_SECTOR_LOADED;
 
-    // We couldn't allocate enough so give back what we got.
-    if (!success) {
-        release_ram_cache();
+    for (size_t i = 0; i < FLASH_CACHE_TABLE_NUM_ENTRIES; i++) {
+        uint8_t *page_cache = port_malloc(SPI_FLASH_PAGE_SIZE, false);
+        if (page_cache == NULL) {
+            // We couldn't allocate enough so give back what we got.
+            release_cache_entry(cache);
+            return NULL;
+        }
+        cache->pages[i] = page_cache;
     }
-    return success;
+    return cache;
 }
 
-// Flush the cached sector from ram onto the flash. We'll free the cache unless
-// keep_cache is true.
-static bool flush_ram_cache(bool keep_cache) {
-    if (flash_cache_table == NULL) {
-        // Nothing to flush because there is no cache.
-        return true;
-    }
-
-    if (current_sector == NO_SECTOR_LOADED) {
-        if (!keep_cache) {
-            release_ram_cache();
-        }
+// Flush a sector cached in ram onto the flash. The entry is kept for reuse.
+static bool flush_cache_entry(flash_cache_t *cache) {
+    if (cache->sector == NO_SECTOR_LOADED) {
         return true;
     }
     // First, copy out any blocks that we haven't touched from the sector
     // we've cached. If we don't do this we'll erase the data during the sector
     // erase below.
-    bool copy_to_ram_ok = true;
     for (size_t i = 0; i < BLOCKS_PER_SECTOR; i++) {
-        if ((dirty_mask & (1 << i)) == 0) {
-            for (size_t j = 0; j < PAGES_PER_BLOCK; j++) {
-                copy_to_ram_ok = read_flash(
-                    current_sector + (i * PAGES_PER_BLOCK + j) * SPI_FLASH_PAGE_SIZE,
-                    flash_cache_table[i * PAGES_PER_BLOCK + j],
-                    SPI_FLASH_PAGE_SIZE);
-                if (!copy_to_ram_ok) {
-                    break;
-                }
-            }
+        if ((cache->dirty_mask & (1 << i)) != 0) {
+            continue;
         }
-        if (!copy_to_ram_ok) {
-            break;
+        for (size_t j = 0; j < PAGES_PER_BLOCK; j++) {
+            if (!read_flash(cache->sector + (i * PAGES_PER_BLOCK + j) * SPI_FLASH_PAGE_SIZE,
+                cache->pages[i * PAGES_PER_BLOCK + j],
+                SPI_FLASH_PAGE_SIZE)) {
+                return false;
+            }
         }
     }
+    // Second, erase the sector.
+    erase_sector(cache->sector);
+    // Lastly, write all the data in ram that we've cached.
+    for (size_t i = 0; i < FLASH_CACHE_TABLE_NUM_ENTRIES; i++) {
+        write_flash(cache->sector + i * SPI_FLASH_PAGE_SIZE, cache->pages[i], SPI_FLASH_PAGE_SIZE);
+    }
+    cache->sector = NO_SECTOR_LOADED;
+    cache->dirty_mask = 0;
+    return true;
+}
 
-    if (!copy_to_ram_ok) {
-        return false;
+// Returns the ram cache entry holding the given sector, if there is one.
+static flash_cache_t *find_cache_entry(uint32_t sector) {
+    for (size_t i = 0; i < CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS; i++) {
+        if (flash_cache[i] != NULL && flash_cache[i]->sector == sector) {
+            return flash_cache[i];
+        }
     }
-    // Second, erase the current sector.
-    erase_sector(current_sector);
-    // Lastly, write all the data in ram that we've cached.
-    for (size_t i = 0; i < BLOCKS_PER_SECTOR; i++) {
-        for (size_t j = 0; j < PAGES_PER_BLOCK; j++) {
-            write_flash(current_sector + (i * PAGES_PER_BLOCK + j) * SPI_FLASH_PAGE_SIZE,
-                flash_cache_table[i * PAGES_PER_BLOCK + j],
-                SPI_FLASH_PAGE_SIZE);
+    return NULL;
+}
+
+// Returns a free ram cache entry for the given sector. Allocates a new entry if
+// there is room for one, and otherwise flushes the least recently written
+// sector to reuse its entry. Returns NULL if no ram cache could be allocated at
+// all.
+static flash_cache_t *get_cache_entry(uint32_t sector) {
+    flash_cache_t *oldest = NULL;
+    for (size_t i = 0; i < CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS; i++) {
+        flash_cache_t *cache = flash_cache[i];
+        if (cache == NULL) {
+            cache = allocate_cache_entry();
+            if (cache == NULL) {
+                // Out of memory so make do with the entries we have.
+                break;
+            }
+            flash_cache[i] = cache;
+        }
+        if (cache->sector == NO_SECTOR_LOADED) {
+            oldest = cache;
+            break;
+        }
+        if (oldest == NULL || cache->last_write - oldest->last_write > UINT32_MAX / 2) {
+            oldest = cache;
         }
     }
-    // We're done with the cache for now so give it back.
-    if (!keep_cache) {
-        release_ram_cache();
+    if (oldest == NULL) {
+        return NULL;
     }
-    return true;
+    if (!flush_cache_entry(oldest)) {
+        return NULL;
+    }
+    oldest->sector = sector;
+    oldest->dirty_mask = 0;
+    return oldest;
 }
 
-// Delegates to the correct flash flush method depending on the existing cache.
+// Flush every cached sector onto the flash. We'll free the ram cache, except
+// for one sector when keep_cache is true.
 // TODO Don't blink the status indicator if we don't actually do any writing (hard to tell right now).
 static void spi_flash_flush_keep_cache(bool keep_cache) {
     #ifdef MICROPY_HW_LED_MSC
     port_pin_set_output_level(MICROPY_HW_LED_MSC, true);
     #endif
     // If we've cached to the flash itself flush from there.
-    if (flash_cache_table == NULL) {
-        flush_scratch_flash();
-    } else {
-        flush_ram_cache(keep_cache);
-    }
+    flush_scratch_flash();
     current_sector = NO_SECTOR_LOADED;
+    for (size_t i = 0; i < CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS; i++) {
+        // An entry that fails to flush keeps its sector and is tried again on
+        // the next flush.
+        if (flash_cache[i] != NULL) {
+            flush_cache_entry(flash_cache[i]);
+        }
+    }
+    // We're done with the flushed entries for now so give them back. Keeping
+    // one saves allocating it again for the next write, like before there
+    // were several.
+    release_ram_cache(keep_cache ? 1 : 0);
     #ifdef MICROPY_HW_LED_MSC
     port_pin_set_output_level(MICROPY_HW_LED_MSC, false);
     #endif
@@ -464,7 +517,7 @@ void supervisor_flash_release_cache(void) {
 }
 
 static int32_t convert_block_to_flash_addr(uint32_t block) {
-    if (0 <= block && block < supervisor_flash_get_block_count()) {
+    if (block < supervisor_flash_get_block_count()) {
         // a block in partition 1
         return block * FILESYSTEM_BLOCK_SIZE;
     }
@@ -483,19 +536,20 @@ static bool external_flash_read_block(uint8_t *dest, uint32_t block) {
     uint32_t this_sector = address & (~(SPI_FLASH_ERASE_SIZE - 1));
     size_t block_index = (address / FILESYSTEM_BLOCK_SIZE) % BLOCKS_PER_SECTOR;
     uint32_t mask = 1 << (block_index);
-    // We're reading from the currently cached sector.
-    if (current_sector == this_sector && (mask & dirty_mask) > 0) {
-        if (flash_cache_table != NULL) {
-            for (int i = 0; i < PAGES_PER_BLOCK; i++) {
-                memcpy(dest + i * SPI_FLASH_PAGE_SIZE,
-                    flash_cache_table[block_index * PAGES_PER_BLOCK + i],
-                    SPI_FLASH_PAGE_SIZE);
-            }
-            return true;
-        } else {
-            uint32_t scratch_address = flash_device->total_size - SPI_FLASH_ERASE_SIZE + block_index * FILESYSTEM_BLOCK_SIZE;
-            return read_flash(scratch_address, dest, FILESYSTEM_BLOCK_SIZE);
+    // We're reading from a sector cached in ram.
+    flash_cache_t *cache = find_cache_entry(this_sector);
+    if (cache != NULL && (mask & cache->dirty_mask) > 0) {
+        for (int i = 0; i < PAGES_PER_BLOCK; i++) {
+            memcpy(dest + i * SPI_FLASH_PAGE_SIZE,
+                cache->pages[block_index * PAGES_PER_BLOCK + i],
+                SPI_FLASH_PAGE_SIZE);
         }
+        return true;
+    }
+    // We're reading from the sector cached in the scratch sector.
+    if (current_sector == this_sector && (mask & dirty_mask) > 0) {
+        uint32_t scratch_address = flash_device->total_size - SPI_FLASH_ERASE_SIZE + block_index * FILESYSTEM_BLOCK_SIZE;
+        return read_flash(scratch_address, dest, FILESYSTEM_BLOCK_SIZE);
     }
     return read_flash(address, dest, FILESYSTEM_BLOCK_SIZE);
 }
@@ -513,37 +567,46 @@ static bool external_flash_write_block(const uint8_t *data, uint32_t block) {
     uint32_t this_sector = address & (~(SPI_FLASH_ERASE_SIZE - 1));
     size_t block_index = (address / FILESYSTEM_BLOCK_SIZE) % BLOCKS_PER_SECTOR;
     uint32_t mask = 1 << (block_index);
-    // Flush the cache if we're moving onto a sector or we're writing the
-    // same block again.
-    if (current_sector != this_sector || (mask & dirty_mask) > 0) {
-        // Check to see if we'd write to an erased page. In that case we
-        // can write directly.
-        if (page_erased(address)) {
+    uint32_t scratch_address = flash_device->total_size - SPI_FLASH_ERASE_SIZE + block_index * FILESYSTEM_BLOCK_SIZE;
+    // A sector cached in ram takes any write to it, even the same block again.
+    flash_cache_t *cache = find_cache_entry(this_sector);
+    if (cache == NULL) {
+        if (current_sector == this_sector) {
+            if ((mask & dirty_mask) == 0) {
+                dirty_mask |= mask;
+                return write_flash(scratch_address, data, FILESYSTEM_BLOCK_SIZE);
+            }
+            // Flush the scratch sector if we're writing the same block again.
+            if (!flush_scratch_flash()) {
+                return false;
+            }
+        } else if (page_erased(address)) {
+            // We'd write to an erased page of a sector that isn't cached, so
+            // we can write directly.
             return write_flash(address, data, FILESYSTEM_BLOCK_SIZE);
         }
-        if (current_sector != NO_SECTOR_LOADED) {
-            supervisor_flash_flush();
-        }
-        if (flash_cache_table == NULL && !allocate_ram_cache()) {
+        cache = get_cache_entry(this_sector);
+        if (cache == NULL) {
+            // No ram so cache the sector in the scratch sector instead.
+            if (!flush_scratch_flash()) {
+                return false;
+            }
             erase_sector(flash_device->total_size - SPI_FLASH_ERASE_SIZE);
             wait_for_flash_ready();
+            current_sector = this_sector;
+            dirty_mask = mask;
+            return write_flash(scratch_address, data, FILESYSTEM_BLOCK_SIZE);
         }
-        current_sector = this_sector;
-        dirty_mask = 0;
     }
-    dirty_mask |= mask;
-    // Copy the block to the appropriate cache.
-    if (flash_cache_table != NULL) {
-        for (int i = 0; i < PAGES_PER_BLOCK; i++) {
-            memcpy(flash_cache_table[block_index * PAGES_PER_BLOCK + i],
-                data + i * SPI_FLASH_PAGE_SIZE,
-                SPI_FLASH_PAGE_SIZE);
-        }
-        return true;
-    } else {
-        uint32_t scratch_address = flash_device->total_size - SPI_FLASH_ERASE_SIZE + block_index * FILESYSTEM_BLOCK_SIZE;
-        return write_flash(scratch_address, data, FILESYSTEM_BLOCK_SIZE);
+    cache->dirty_mask |= mask;
+    cache->last_write = ++flash_cache_clock;
+    // Copy the block to the cache.
+    for (int i = 0; i < PAGES_PER_BLOCK; i++) {
+        memcpy(cache->pages[block_index * PAGES_PER_BLOCK + i],
+            data + i * SPI_FLASH_PAGE_SIZE,
+            SPI_FLASH_PAGE_SIZE);
     }
+    return true;
 }
 
 mp_uint_t supervisor_flash_read_blocks(uint8_t *dest, uint32_t block_num, uint32_t num_blocks) {
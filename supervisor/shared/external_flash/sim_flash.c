@@ -0,0 +1,166 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2025 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+#include "supervisor/spi_flash_api.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include "py/misc.h"
+#include "supervisor/shared/external_flash/common_commands.h"
+#include "supervisor/shared/external_flash/sim_flash.h"
+
+#define SIM_FLASH_REGIONS (SIM_FLASH_TOTAL_SIZE / SIM_FLASH_MIN_ERASE_SIZE)
+
+// Status register bits.
+#define STATUS_WRITE_ENABLED 0x02
+
+static uint8_t sim_flash_data[SIM_FLASH_TOTAL_SIZE];
+static uint32_t sim_flash_region_erases[SIM_FLASH_REGIONS];
+static bool sim_flash_write_enabled;
+
+static sim_flash_config_t sim_flash_config = {
+    .page_size = 256,
+    .erase_size = 4096,
+    .page_program_us = 700,
+    .sector_erase_us = 45000,
+    .bytes_per_us = 4,
+};
+
+static sim_flash_stats_t sim_flash_stats;
+
+// Account for sending a command byte, a 24 bit address if there is one and the
+// data.
+static void transfer(bool address, uint32_t data_length) {
+    uint32_t bytes = 1 + (address ? 3 : 0) + data_length;
+    sim_flash_stats.elapsed_us += (bytes + sim_flash_config.bytes_per_us - 1) / sim_flash_config.bytes_per_us;
+}
+
+bool sim_flash_configure(const sim_flash_config_t *config) {
+    if (config->page_size == 0 || (config->page_size & (config->page_size - 1)) != 0 ||
+        config->page_size > config->erase_size ||
+        config->erase_size < SIM_FLASH_MIN_ERASE_SIZE ||
+        (config->erase_size & (config->erase_size - 1)) != 0 ||
+        config->erase_size > SIM_FLASH_TOTAL_SIZE ||
+        config->bytes_per_us == 0) {
+        return false;
+    }
+    sim_flash_config = *config;
+    memset(sim_flash_data, 0xff, sizeof(sim_flash_data));
+    sim_flash_write_enabled = false;
+    sim_flash_reset_stats();
+    return true;
+}
+
+void sim_flash_get_stats(sim_flash_stats_t *stats) {
+    *stats = sim_flash_stats;
+    stats->max_region_erases = 0;
+    for (size_t i = 0; i < SIM_FLASH_REGIONS; i++) {
+        if (sim_flash_region_erases[i] > stats->max_region_erases) {
+            stats->max_region_erases = sim_flash_region_erases[i];
+        }
+    }
+}
+
+void sim_flash_reset_stats(void) {
+    memset(&sim_flash_stats, 0, sizeof(sim_flash_stats));
+    memset(sim_flash_region_erases, 0, sizeof(sim_flash_region_erases));
+}
+
+void sim_flash_delay_us(uint32_t us) {
+    sim_flash_stats.elapsed_us += us;
+}
+
+bool spi_flash_command(uint8_t command) {
+    transfer(false, 0);
+    if (command == CMD_ENABLE_WRITE) {
+        sim_flash_write_enabled = true;
+    } else if (command == CMD_DISABLE_WRITE) {
+        sim_flash_write_enabled = false;
+    }
+    return true;
+}
+
+bool spi_flash_read_command(uint8_t command, uint8_t *response, uint32_t length) {
+    transfer(false, length);
+    memset(response, 0, length);
+    if (command == CMD_READ_JEDEC_ID) {
+        const external_flash_device device = SIM_FLASH;
+        const uint8_t id[] = {device.manufacturer_id, device.memory_type, device.capacity};
+        memcpy(response, id, MIN(length, sizeof(id)));
+    } else if (command == CMD_READ_STATUS && length > 0) {
+        // Programs and erases finish immediately, so the busy bit is never set.
+        response[0] = sim_flash_write_enabled ? STATUS_WRITE_ENABLED : 0;
+    }
+    return true;
+}
+
+bool spi_flash_write_command(uint8_t command, uint8_t *data, uint32_t length) {
+    (void)command;
+    (void)data;
+    transfer(false, length);
+    // Writing the status registers clears the write enable latch like any
+    // other write.
+    sim_flash_write_enabled = false;
+    return true;
+}
+
+bool spi_flash_sector_command(uint8_t command, uint32_t address) {
+    transfer(true, 0);
+    if (command != CMD_SECTOR_ERASE || address >= SIM_FLASH_TOTAL_SIZE || !sim_flash_write_enabled) {
+        return false;
+    }
+    sim_flash_write_enabled = false;
+    uint32_t start = address & ~(sim_flash_config.erase_size - 1);
+    memset(sim_flash_data + start, 0xff, sim_flash_config.erase_size);
+    for (uint32_t i = 0; i < sim_flash_config.erase_size / SIM_FLASH_MIN_ERASE_SIZE; i++) {
+        sim_flash_region_erases[start / SIM_FLASH_MIN_ERASE_SIZE + i]++;
+    }
+    sim_flash_stats.sector_erases++;
+    sim_flash_stats.elapsed_us += sim_flash_config.sector_erase_us;
+    return true;
+}
+
+bool spi_flash_write_data(uint32_t address, uint8_t *data, uint32_t data_length) {
+    transfer(true, data_length);
+    if (address >= SIM_FLASH_TOTAL_SIZE || data_length > sim_flash_config.page_size || !sim_flash_write_enabled) {
+        return false;
+    }
+    sim_flash_write_enabled = false;
+    // Like a real device, wrap around to the start of the page rather than
+    // carrying on into the next one.
+    uint32_t page = address & ~(sim_flash_config.page_size - 1);
+    uint32_t offset = address - page;
+    for (uint32_t i = 0; i < data_length; i++) {
+        uint8_t *cell = &sim_flash_data[page + offset];
+        // Programming can only clear bits.
+        if ((*cell & data[i]) != data[i]) {
+            sim_flash_stats.program_errors++;
+        }
+        *cell &= data[i];
+        offset = (offset + 1) & (sim_flash_config.page_size - 1);
+    }
+    sim_flash_stats.page_programs++;
+    sim_flash_stats.bytes_programmed += data_length;
+    sim_flash_stats.elapsed_us += sim_flash_config.page_program_us;
+    return true;
+}
+
+bool spi_flash_read_data(uint32_t address, uint8_t *data, uint32_t data_length) {
+    transfer(true, data_length);
+    if (address > SIM_FLASH_TOTAL_SIZE || data_length > SIM_FLASH_TOTAL_SIZE - address) {
+        return false;
+    }
+    memcpy(data, sim_flash_data + address, data_length);
+    sim_flash_stats.bytes_read += data_length;
+    return true;
+}
+
+void spi_flash_init(void) {
+}
+
+void spi_flash_init_device(const external_flash_device *device) {
+    (void)device;
+}
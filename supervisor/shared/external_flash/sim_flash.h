@@ -0,0 +1,71 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2025 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// A RAM backed NOR flash that implements spi_flash_api.h, so that the external
+// flash layer can be measured and tested off-device.
+
+#ifndef SIM_FLASH_TOTAL_SIZE
+#define SIM_FLASH_TOTAL_SIZE (2 * 1024 * 1024)
+#endif
+
+// The smallest erase size the simulator supports, and the granularity of its
+// wear counts.
+#define SIM_FLASH_MIN_ERASE_SIZE (4096)
+
+// Device description used in place of genhdr/devices.h entries.
+#define SIM_FLASH {\
+        .total_size = SIM_FLASH_TOTAL_SIZE, \
+        .start_up_time_us = 5000, \
+        .manufacturer_id = 0xef, \
+        .memory_type = 0x40, \
+        .capacity = 0x15, \
+        .max_clock_speed_mhz = 104, \
+        .quad_enable_bit_mask = 0x02, \
+        .has_sector_protection = false, \
+        .supports_fast_read = true, \
+        .supports_qspi = true, \
+        .supports_qspi_writes = true, \
+        .write_status_register_split = false, \
+        .single_status_byte = false, \
+}
+
+typedef struct {
+    // Bytes per page program. Programs wrap around within a page, as on a real
+    // device.
+    uint32_t page_size;
+    // Bytes cleared by a sector erase. A power of two, at least
+    // SIM_FLASH_MIN_ERASE_SIZE.
+    uint32_t erase_size;
+    uint32_t page_program_us;
+    uint32_t sector_erase_us;
+    // Bus throughput, used for the time taken by command and data transfers.
+    uint32_t bytes_per_us;
+} sim_flash_config_t;
+
+typedef struct {
+    uint32_t sector_erases;
+    uint32_t page_programs;
+    uint32_t bytes_programmed;
+    uint32_t bytes_read;
+    // Erases of the most worn SIM_FLASH_MIN_ERASE_SIZE region.
+    uint32_t max_region_erases;
+    // Programs that tried to set a bit that was already clear.
+    uint32_t program_errors;
+    // Simulated time spent on transfers, programs, erases and delays.
+    uint64_t elapsed_us;
+} sim_flash_stats_t;
+
+// Sets the geometry and timing and erases the whole device. Returns false if
+// the config is invalid.
+bool sim_flash_configure(const sim_flash_config_t *config);
+void sim_flash_get_stats(sim_flash_stats_t *stats);
+void sim_flash_reset_stats(void);
+// Accounts for a delay done while waiting on the flash.
+void sim_flash_delay_us(uint32_t us);
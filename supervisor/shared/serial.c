@@ -11,6 +11,7 @@
 #include "py/mphal.h"
 #include "py/mpprint.h"
 
+#include "supervisor/background_callback.h"
 #include "supervisor/shared/cpu.h"
 #include "supervisor/shared/display.h"
 #include "shared-bindings/terminalio/Terminal.h"
@@ -66,6 +67,23 @@ static bool _serial_display_write_disabled;
 // Indicates that serial console has been early initialized.
 static bool _serial_console_early_inited = false;
 
+#if CIRCUITPY_SERIAL_OUTPUT_BUFFER_SIZE > 0
+// Output is gathered here and sent on to every output at once, so that many
+// short writes turn into fewer USB packets and terminal redraws. It is sent on
+// the next time background tasks run, when it fills up, before input is read
+// and at a newline once it is half full.
+static char _serial_output_buffer[CIRCUITPY_SERIAL_OUTPUT_BUFFER_SIZE];
+static size_t _serial_output_len;
+static bool _serial_output_flushing;
+static background_callback_t _serial_flush_callback;
+
+static void serial_flush_callback(void *unused) {
+    serial_flush();
+}
+#endif
+
+static uint32_t serial_write_now(const char *text, uint32_t length);
+
 #if CIRCUITPY_CONSOLE_UART
 
 // All output to the console uart comes through this inner write function. It ensures that all
@@ -273,6 +291,9 @@ bool serial_connected(void) {
 }
 
 char serial_read(void) {
+    // Show any prompt or echo before waiting on input.
+    serial_flush();
+
     #if CIRCUITPY_TINYUSB && CIRCUITPY_USB_DEVICE && CIRCUITPY_USB_VENDOR
     if (tud_vendor_connected() && tud_vendor_available() > 0) {
         char tiny_buffer;
@@ -335,6 +356,8 @@ char serial_read(void) {
 }
 
 uint32_t serial_bytes_available(void) {
+    serial_flush();
+
     // There may be multiple serial input channels, so sum the count from all.
     uint32_t count = 0;
 
@@ -377,11 +400,48 @@ uint32_t serial_bytes_available(void) {
     return count;
 }
 
+void serial_flush(void) {
+    #if CIRCUITPY_SERIAL_OUTPUT_BUFFER_SIZE > 0
+    if (_serial_output_len == 0 || _serial_output_flushing) {
+        return;
+    }
+    // Writing may run background tasks, so don't let them flush again or add
+    // to the buffer while it's being sent.
+    _serial_output_flushing = true;
+    serial_write_now(_serial_output_buffer, _serial_output_len);
+    _serial_output_len = 0;
+    _serial_output_flushing = false;
+    #endif
+}
+
 uint32_t serial_write_substring(const char *text, uint32_t length) {
     if (length == 0) {
         return 0;
     }
 
+    #if CIRCUITPY_SERIAL_OUTPUT_BUFFER_SIZE > 0
+    // Output from interrupts goes straight out.
+    if (!cpu_interrupt_active() && !_serial_output_flushing) {
+        if (_serial_output_len + length > CIRCUITPY_SERIAL_OUTPUT_BUFFER_SIZE) {
+            serial_flush();
+        }
+        if (length < CIRCUITPY_SERIAL_OUTPUT_BUFFER_SIZE) {
+            memcpy(_serial_output_buffer + _serial_output_len, text, length);
+            _serial_output_len += length;
+            if (_serial_output_len >= CIRCUITPY_SERIAL_OUTPUT_BUFFER_SIZE / 2 && memchr(text, '\n', length) != NULL) {
+                serial_flush();
+            } else {
+                background_callback_add(&_serial_flush_callback, serial_flush_callback, NULL);
+            }
+            return length;
+        }
+    }
+    #endif
+
+    return serial_write_now(text, length);
+}
+
+static uint32_t serial_write_now(const char *text, uint32_t length) {
     // See https://github.com/micropython/micropython/pull/11850 for the motivation for returning
     // the number of chars written.
 
@@ -456,12 +516,15 @@ void serial_write(const char *text) {
 }
 
 bool serial_console_write_disable(bool disabled) {
+    // Send what was written before according to the old setting.
+    serial_flush();
     bool now = _serial_console_write_disabled;
     _serial_console_write_disabled = disabled;
     return now;
 }
 
 bool serial_display_write_disable(bool disabled) {
+    serial_flush();
     bool now = _serial_display_write_disabled;
     _serial_display_write_disabled = disabled;
     return now;
@@ -25,6 +25,8 @@ void serial_init(void);
 void serial_write(const char *text);
 // Only writes up to given length. Does not check for null termination at all.
 uint32_t serial_write_substring(const char *text, uint32_t length);
+// Send on any output that is still buffered.
+void serial_flush(void);
 char serial_read(void);
 uint32_t serial_bytes_available(void);
 bool serial_connected(void);
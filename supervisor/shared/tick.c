@@ -39,6 +39,14 @@
 static volatile uint64_t PLACE_IN_DTCM_BSS(background_ticks);
 
 static background_callback_t tick_callback;
+// Display refresh and filesystem flushes can take a while, so they run as
+// their own, lower priority, callbacks.
+#if CIRCUITPY_DISPLAYIO
+static background_callback_t display_tick_callback = {
+    .budget_us = BACKGROUND_CALLBACK_DISPLAY_BUDGET_US,
+};
+#endif
+static background_callback_t filesystem_tick_callback;
 
 static volatile uint64_t last_finished_tick = 0;
 
@@ -53,12 +61,6 @@ static void supervisor_background_tick(void *unused) {
     bleio_hci_background();
     #endif
 
-    #if CIRCUITPY_DISPLAYIO
-    displayio_background();
-    #endif
-
-    filesystem_background();
-
     port_background_tick();
 
     assert_heap_ok();
@@ -68,6 +70,16 @@ static void supervisor_background_tick(void *unused) {
     port_finish_background_tick();
 }
 
+#if CIRCUITPY_DISPLAYIO
+static void supervisor_display_tick(void *unused) {
+    displayio_background();
+}
+#endif
+
+static void supervisor_filesystem_tick(void *unused) {
+    filesystem_background();
+}
+
 bool supervisor_background_ticks_ok(void) {
     return port_get_raw_ticks(NULL) - last_finished_tick < 1024;
 }
@@ -83,6 +95,10 @@ void supervisor_tick(void) {
     #endif
 
     background_callback_add(&tick_callback, supervisor_background_tick, NULL);
+    #if CIRCUITPY_DISPLAYIO
+    background_callback_add_with_priority(&display_tick_callback, supervisor_display_tick, NULL, BACKGROUND_CALLBACK_PRIORITY_DISPLAY);
+    #endif
+    background_callback_add_with_priority(&filesystem_tick_callback, supervisor_filesystem_tick, NULL, BACKGROUND_CALLBACK_PRIORITY_FILESYSTEM);
 }
 
 static uint64_t _get_raw_subticks(void) {
@@ -157,7 +157,9 @@ static void send_bufn_core(const char *buf, size_t n) {
     for (; n--; buf++) {
         int code = *buf;
         if (code == mp_interrupt_char) {
-            ringbuf_clear(&_incoming_ringbuf);
+            // The reader runs on the same thread, so it can't be partway
+            // through a get.
+            ringbuf_drop_pending(&_incoming_ringbuf);
             mp_sched_keyboard_interrupt();
             continue;
         }
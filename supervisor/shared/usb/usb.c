@@ -194,7 +194,7 @@ static void usb_background_do(void *unused) {
 }
 
 void PLACE_IN_ITCM(usb_background_schedule)(void) {
-    background_callback_add(&usb_callback, usb_background_do, NULL);
+    background_callback_add_with_priority(&usb_callback, usb_background_do, NULL, BACKGROUND_CALLBACK_PRIORITY_USB);
 }
 
 void PLACE_IN_ITCM(usb_irq_handler)(int instance) {
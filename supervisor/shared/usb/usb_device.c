@@ -184,10 +184,19 @@ void tud_cdc_send_break_cb(uint8_t itf, uint16_t duration_ms) {
     }
 }
 
+#endif
+
+#if CIRCUITPY_USB_CDC
 void tud_cdc_rx_cb(uint8_t itf) {
-    (void)itf;
     // Workaround for "press any key to enter REPL" response being delayed on espressif.
     // Wake main task when any key is pressed.
     port_wake_main_task();
+    // Tell select.poll that there is data to read.
+    usb_cdc_poll_notify(itf);
+}
+
+// Invoked when a transfer to the host completes, making room to write again.
+void tud_cdc_tx_complete_cb(uint8_t itf) {
+    usb_cdc_poll_notify(itf);
 }
 #endif
@@ -51,6 +51,97 @@ static bool locked[LUN_COUNT] = { [0 ... (LUN_COUNT - 1)] = false};
 // Used to determine if an auto-reload is warranted.
 static bool content_write[LUN_COUNT] = { [0 ... (LUN_COUNT - 1)] = false};
 
+static fs_user_mount_t *get_vfs(int lun);
+
+// TinyUSB hands over at most CFG_TUD_MSC_BUFSIZE bytes per callback. When that
+// is smaller than CIRCUITPY_USB_MSC_BATCH_BLOCKS blocks, sequential reads are
+// read ahead and sequential writes are gathered, so that the block device sees
+// fewer, larger transfers and most callbacks return straight away.
+#if defined(CFG_TUD_MSC_BUFSIZE) && CIRCUITPY_USB_MSC_BATCH_BLOCKS * MSC_FLASH_BLOCK_SIZE > CFG_TUD_MSC_BUFSIZE
+#define MSC_BATCH_BLOCKS CIRCUITPY_USB_MSC_BATCH_BLOCKS
+#else
+#define MSC_BATCH_BLOCKS 0
+#endif
+
+#if MSC_BATCH_BLOCKS > 0
+typedef enum {
+    MSC_BATCH_NONE,
+    MSC_BATCH_READ,
+    MSC_BATCH_WRITE,
+} msc_batch_mode_t;
+
+static uint8_t msc_batch_buffer[MSC_BATCH_BLOCKS * MSC_FLASH_BLOCK_SIZE];
+static msc_batch_mode_t msc_batch_mode;
+static uint8_t msc_batch_lun;
+static uint32_t msc_batch_lba;
+static uint32_t msc_batch_count;
+// The block after the last one read, used to spot sequential reads.
+static uint32_t msc_next_read_lba[LUN_COUNT];
+
+static void msc_batch_flush(void) {
+    if (msc_batch_mode == MSC_BATCH_WRITE) {
+        fs_user_mount_t *vfs = get_vfs(msc_batch_lun);
+        if (vfs != NULL) {
+            disk_write(vfs, msc_batch_buffer, msc_batch_lba, msc_batch_count);
+        }
+    }
+    msc_batch_mode = MSC_BATCH_NONE;
+    msc_batch_count = 0;
+}
+
+static bool msc_batch_read(fs_user_mount_t *vfs, uint8_t lun, void *buffer, uint32_t lba, uint32_t block_count, uint32_t disk_block_count) {
+    // Writes are flushed when their command completes, but be sure.
+    if (msc_batch_mode == MSC_BATCH_WRITE) {
+        msc_batch_flush();
+    }
+    const bool sequential = lba == msc_next_read_lba[lun];
+    msc_next_read_lba[lun] = lba + block_count;
+    if (block_count >= MSC_BATCH_BLOCKS) {
+        return false;
+    }
+    if (msc_batch_mode != MSC_BATCH_READ || msc_batch_lun != lun ||
+        lba < msc_batch_lba || lba + block_count > msc_batch_lba + msc_batch_count) {
+        // Only read ahead once reads are sequential, so that the lone reads of
+        // directories and the FAT don't cost any extra.
+        if (!sequential) {
+            return false;
+        }
+        msc_batch_flush();
+        msc_batch_count = MIN(MSC_BATCH_BLOCKS, disk_block_count - lba);
+        if (disk_read(vfs, msc_batch_buffer, lba, msc_batch_count) != RES_OK) {
+            msc_batch_count = 0;
+            return false;
+        }
+        msc_batch_mode = MSC_BATCH_READ;
+        msc_batch_lun = lun;
+        msc_batch_lba = lba;
+    }
+    memcpy(buffer, msc_batch_buffer + (lba - msc_batch_lba) * MSC_FLASH_BLOCK_SIZE, block_count * MSC_FLASH_BLOCK_SIZE);
+    return true;
+}
+
+static bool msc_batch_write(uint8_t lun, const uint8_t *buffer, uint32_t lba, uint32_t block_count) {
+    if (block_count >= MSC_BATCH_BLOCKS) {
+        msc_batch_flush();
+        return false;
+    }
+    if (msc_batch_mode != MSC_BATCH_WRITE || msc_batch_lun != lun ||
+        lba != msc_batch_lba + msc_batch_count ||
+        msc_batch_count + block_count > MSC_BATCH_BLOCKS) {
+        msc_batch_flush();
+        msc_batch_mode = MSC_BATCH_WRITE;
+        msc_batch_lun = lun;
+        msc_batch_lba = lba;
+    }
+    memcpy(msc_batch_buffer + msc_batch_count * MSC_FLASH_BLOCK_SIZE, buffer, block_count * MSC_FLASH_BLOCK_SIZE);
+    msc_batch_count += block_count;
+    if (msc_batch_count == MSC_BATCH_BLOCKS) {
+        msc_batch_flush();
+    }
+    return true;
+}
+#endif
+
 #include "tusb.h"
 
 static const uint8_t usb_msc_descriptor_template[] = {
@@ -292,11 +383,29 @@ int32_t tud_msc_read10_cb(uint8_t lun, uint32_t lba, uint32_t offset, void *buff
         return -1;
     }
 
+    #if MSC_BATCH_BLOCKS > 0
+    if (msc_batch_read(vfs, lun, buffer, lba, block_count, disk_block_count)) {
+        return block_count * MSC_FLASH_BLOCK_SIZE;
+    }
+    #endif
+
     disk_read(vfs, buffer, lba, block_count);
 
     return block_count * MSC_FLASH_BLOCK_SIZE;
 }
 
+// Callback invoked when READ10 command is completed.
+void tud_msc_read10_complete_cb(uint8_t lun) {
+    (void)lun;
+    #if MSC_BATCH_BLOCKS > 0
+    // Read ahead data isn't kept between commands, because CircuitPython may
+    // change the filesystem in between.
+    if (msc_batch_mode == MSC_BATCH_READ) {
+        msc_batch_flush();
+    }
+    #endif
+}
+
 // Callback invoked when received WRITE10 command.
 // Process data in buffer to disk's storage and return number of written bytes
 int32_t tud_msc_write10_cb(uint8_t lun, uint32_t lba, uint32_t offset, uint8_t *buffer, uint32_t bufsize) {
@@ -311,7 +420,12 @@ int32_t tud_msc_write10_cb(uint8_t lun, uint32_t lba, uint32_t offset, uint8_t *
         return -1;
     }
 
-    disk_write(vfs, buffer, lba, block_count);
+    #if MSC_BATCH_BLOCKS > 0
+    if (!msc_batch_write(lun, buffer, lba, block_count))
+    #endif
+    {
+        disk_write(vfs, buffer, lba, block_count);
+    }
     // Since by getting here we assume the mount is read-only to
     // CircuitPython let's update the cached FatFs sector if it's the one
     // we just wrote.
@@ -343,6 +457,11 @@ int32_t tud_msc_write10_cb(uint8_t lun, uint32_t lba, uint32_t offset, uint8_t *
 // Callback invoked when WRITE10 command is completed (status received and accepted by host).
 // used to flush any pending cache.
 void tud_msc_write10_complete_cb(uint8_t lun) {
+    #if MSC_BATCH_BLOCKS > 0
+    // Write out anything gathered before the host moves on.
+    msc_batch_flush();
+    #endif
+
     autoreload_resume(AUTORELOAD_SUSPEND_USB);
 
     // This write is complete; initiate an autoreload if this was a file data or metadata write,
@@ -23,11 +23,16 @@
 #include "supervisor/fatfs.h"
 #include "supervisor/filesystem.h"
 #include "supervisor/port.h"
+#include "supervisor/port_heap.h"
 #include "supervisor/shared/reload.h"
 #include "supervisor/shared/web_workflow/web_workflow.h"
 #include "supervisor/shared/web_workflow/websocket.h"
 #include "supervisor/shared/workflow.h"
 
+#if CIRCUITPY_ZLIB
+#include "lib/uzlib/uzlib.h"
+#endif
+
 #include "shared-bindings/hashlib/__init__.h"
 #include "shared-bindings/hashlib/Hash.h"
 
@@ -74,6 +79,7 @@ typedef struct {
     char header_value[256];
     char origin[64];        // We store the origin so we can reply back with it.
     char host[64];          // We store the host to check against origin.
+    char if_none_match[64];
     size_t content_length;
     size_t offset;
     uint64_t timestamp_ms;
@@ -83,6 +89,7 @@ typedef struct {
     bool authenticated;
     bool expect;
     bool json;
+    bool accept_gzip;
     bool websocket;
     bool new_socket;
     uint32_t websocket_version;
@@ -120,6 +127,30 @@ static _request active_request;
 static char _api_password[64];
 static char web_instance_name[50];
 
+typedef struct {
+    uint32_t fsize;
+    WORD fdate;
+    WORD ftime;
+    BYTE fattrib;
+    char fname[];
+} _directory_entry_t;
+
+// The last directory listed, sorted by name. It is rebuilt once its filesystem
+// is remounted or written to.
+typedef struct {
+    fs_user_mount_t *fs_mount;
+    WORD fs_id;
+    uint32_t write_count;
+    char path[256];
+    // Entries are packed at the start of data, followed by count offsets to
+    // them in sorted order.
+    uint8_t *data;
+    size_t count;
+    uint32_t *sorted;
+} _directory_cache_t;
+
+static _directory_cache_t _directory_cache;
+
 // Store the encoded IP so we don't duplicate work.
 static uint32_t _encoded_ip = 0;
 static char _our_ip_encoded[4 * 4];
@@ -605,13 +636,21 @@ static void _reply_access_control(socketpool_socket_obj_t *socket, _request *req
         "HTTP/1.1 204 No Content\r\n",
         "Content-Length: 0\r\n",
         "Access-Control-Expose-Headers: Access-Control-Allow-Methods\r\n",
-        "Access-Control-Allow-Headers: X-Timestamp, X-Destination, Content-Type, Authorization\r\n",
+        "Access-Control-Allow-Headers: X-Timestamp, X-Destination, Content-Type, Authorization, If-None-Match\r\n",
         "Access-Control-Allow-Methods:GET, OPTIONS, PUT, DELETE, MOVE", NULL);
     _send_str(socket, "\r\n");
     _cors_header(socket, request);
     _send_final_str(socket, "\r\n");
 }
 
+static void _reply_not_modified(socketpool_socket_obj_t *socket, _request *request, const char *etag) {
+    _send_strs(socket,
+        "HTTP/1.1 304 Not Modified\r\n",
+        "ETag: ", etag, "\r\n", NULL);
+    _cors_header(socket, request);
+    _send_final_str(socket, "\r\n");
+}
+
 static void _reply_missing(socketpool_socket_obj_t *socket, _request *request) {
     _send_strs(socket,
         "HTTP/1.1 404 Not Found\r\n",
@@ -713,13 +752,150 @@ static void _reply_redirect(socketpool_socket_obj_t *socket, _request *request,
 }
 #endif
 
+static void _clear_directory_cache(void) {
+    port_free(_directory_cache.data);
+    _directory_cache.data = NULL;
+    _directory_cache.count = 0;
+}
+
+static bool _directory_cache_valid(fs_user_mount_t *fs_mount, const char *path) {
+    FATFS *fatfs = &fs_mount->fatfs;
+    return _directory_cache.data != NULL &&
+           _directory_cache.fs_mount == fs_mount &&
+           _directory_cache.fs_id == fatfs->id &&
+           _directory_cache.write_count == fs_mount->write_count &&
+           // Changes that haven't been written out yet.
+           !fatfs->wflag &&
+           strcmp(_directory_cache.path, path) == 0;
+}
+
+static const _directory_entry_t *_cached_entry(size_t i) {
+    return (const _directory_entry_t *)(_directory_cache.data + _directory_cache.sorted[i]);
+}
+
+static int _compare_entries(const _directory_entry_t *a, const _directory_entry_t *b) {
+    int result = strcasecmp(a->fname, b->fname);
+    return result != 0 ? result : strcmp(a->fname, b->fname);
+}
+
+// Read the whole directory into the cache. Returns false, with the directory
+// rewound, if it doesn't fit.
+static bool _cache_directory(fs_user_mount_t *fs_mount, FF_DIR *dir, const char *path) {
+    _clear_directory_cache();
+    if (strlen(path) >= sizeof(_directory_cache.path)) {
+        return false;
+    }
+    const size_t capacity = CIRCUITPY_WEB_WORKFLOW_DIRECTORY_CACHE_SIZE & ~3;
+    uint8_t *data = port_malloc(capacity, false);
+    if (data == NULL) {
+        return false;
+    }
+    // Offsets are stored backwards from the end until all entries are in.
+    uint32_t *offsets_end = (uint32_t *)(data + capacity);
+    size_t used = 0;
+    size_t count = 0;
+    FILINFO file_info;
+    FRESULT res;
+    while ((res = f_readdir(dir, &file_info)) == FR_OK && file_info.fname[0] != '\0') {
+        size_t entry_size = (offsetof(_directory_entry_t, fname) + strlen(file_info.fname) + 1 + 3) & ~3;
+        if (used + entry_size + (count + 1) * sizeof(uint32_t) > capacity) {
+            res = FR_NOT_ENOUGH_CORE;
+            break;
+        }
+        _directory_entry_t *entry = (_directory_entry_t *)(data + used);
+        entry->fsize = file_info.fsize;
+        entry->fdate = file_info.fdate;
+        entry->ftime = file_info.ftime;
+        entry->fattrib = file_info.fattrib;
+        strcpy(entry->fname, file_info.fname);
+        count++;
+        offsets_end[-count] = used;
+        used += entry_size;
+    }
+    if (res != FR_OK) {
+        port_free(data);
+        f_readdir(dir, NULL);
+        return false;
+    }
+
+    // Move the offsets up against the entries and give back the rest.
+    uint32_t *sorted = (uint32_t *)(data + used);
+    memmove(sorted, offsets_end - count, count * sizeof(uint32_t));
+    uint8_t *shrunk = port_realloc(data, used + count * sizeof(uint32_t), false);
+    if (shrunk != NULL) {
+        data = shrunk;
+        sorted = (uint32_t *)(data + used);
+    }
+    // Insertion sort, since directories are small and this needs no extra
+    // memory.
+    for (size_t i = 1; i < count; i++) {
+        uint32_t offset = sorted[i];
+        const _directory_entry_t *entry = (const _directory_entry_t *)(data + offset);
+        size_t j = i;
+        while (j > 0 && _compare_entries((const _directory_entry_t *)(data + sorted[j - 1]), entry) > 0) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = offset;
+    }
+
+    _directory_cache.fs_mount = fs_mount;
+    _directory_cache.fs_id = fs_mount->fatfs.id;
+    _directory_cache.write_count = fs_mount->write_count;
+    strcpy(_directory_cache.path, path);
+    _directory_cache.data = data;
+    _directory_cache.count = count;
+    _directory_cache.sorted = sorted;
+    return true;
+}
+
+static void _send_directory_entry(socketpool_socket_obj_t *socket, bool first, const char *name, BYTE fattrib, WORD fdate, WORD ftime, FSIZE_t fsize) {
+    mp_print_t _socket_print = {socket, _print_chunk};
+    if (!first) {
+        _send_chunk(socket, ",");
+    }
+    _send_chunks(socket,
+        "{\"name\": \"", name, "\",",
+        "\"directory\": ", NULL);
+    if ((fattrib & AM_DIR) != 0) {
+        _send_chunk(socket, "true");
+    } else {
+        _send_chunk(socket, "false");
+    }
+    // We use nanoseconds past Jan 1, 1970 for consistency with BLE API and
+    // LittleFS.
+    _send_chunk(socket, ", ");
+
+    uint32_t truncated_time = timeutils_mktime(1980 + (fdate >> 9),
+        (fdate >> 5) & 0xf,
+        fdate & 0x1f,
+        ftime >> 11,
+        (ftime >> 5) & 0x3f,
+        (ftime & 0x1f) * 2);
+
+    // Manually append zeros to make the time nanoseconds. Support for printing 64 bit numbers
+    // varies across chipsets.
+    mp_printf(&_socket_print, "\"modified_ns\": %lu000000000, ", truncated_time);
+    size_t file_size = 0;
+    if ((fattrib & AM_DIR) == 0) {
+        file_size = fsize;
+    }
+    mp_printf(&_socket_print, "\"file_size\": %d }", file_size);
+}
+
 static void _reply_directory_json(socketpool_socket_obj_t *socket, _request *request, fs_user_mount_t *fs_mount, FF_DIR *dir, const char *request_path, const char *path) {
+    // Directories that fit in the cache are listed from it, sorted by name.
+    // Others are streamed from the filesystem in directory order.
+    bool cached = _directory_cache_valid(fs_mount, path) || _cache_directory(fs_mount, dir, path);
     FILINFO file_info;
     char *fn = file_info.fname;
-    FRESULT res = f_readdir(dir, &file_info);
-    if (res != FR_OK) {
-        _reply_missing(socket, request);
-        return;
+    FRESULT res = FR_OK;
+    if (!cached) {
+        res = f_readdir(dir, &file_info);
+        if (res != FR_OK) {
+            _reply_missing(socket, request);
+            return;
+        }
     }
 
     socketpool_socket_send(socket, (const uint8_t *)OK_JSON, strlen(OK_JSON));
@@ -756,53 +932,30 @@ static void _reply_directory_json(socketpool_socket_obj_t *socket, _request *req
 
     // Send file list
     _send_chunk(socket, "\"files\": [");
-    bool first = true;
-
-    while (res == FR_OK && fn[0] != 0) {
-        if (!first) {
-            _send_chunk(socket, ",");
+    if (cached) {
+        for (size_t i = 0; i < _directory_cache.count; i++) {
+            const _directory_entry_t *entry = _cached_entry(i);
+            _send_directory_entry(socket, i == 0, entry->fname, entry->fattrib, entry->fdate, entry->ftime, entry->fsize);
         }
-        _send_chunks(socket,
-            "{\"name\": \"", file_info.fname, "\",",
-            "\"directory\": ", NULL);
-        if ((file_info.fattrib & AM_DIR) != 0) {
-            _send_chunk(socket, "true");
-        } else {
-            _send_chunk(socket, "false");
-        }
-        // We use nanoseconds past Jan 1, 1970 for consistency with BLE API and
-        // LittleFS.
-        _send_chunk(socket, ", ");
-
-        uint32_t truncated_time = timeutils_mktime(1980 + (file_info.fdate >> 9),
-            (file_info.fdate >> 5) & 0xf,
-            file_info.fdate & 0x1f,
-            file_info.ftime >> 11,
-            (file_info.ftime >> 5) & 0x3f,
-            (file_info.ftime & 0x1f) * 2);
-
-        // Manually append zeros to make the time nanoseconds. Support for printing 64 bit numbers
-        // varies across chipsets.
-        mp_printf(&_socket_print, "\"modified_ns\": %lu000000000, ", truncated_time);
-        size_t file_size = 0;
-        if ((file_info.fattrib & AM_DIR) == 0) {
-            file_size = file_info.fsize;
+    } else {
+        bool first = true;
+        while (res == FR_OK && fn[0] != 0) {
+            _send_directory_entry(socket, first, fn, file_info.fattrib, file_info.fdate, file_info.ftime, file_info.fsize);
+            first = false;
+            res = f_readdir(dir, &file_info);
         }
-        mp_printf(&_socket_print, "\"file_size\": %d }", file_size);
-
-        first = false;
-        res = f_readdir(dir, &file_info);
     }
     _send_chunk(socket, "]}");
     _send_chunk(socket, "");
 }
 
-static void _reply_with_file(socketpool_socket_obj_t *socket, _request *request, const char *filename, FIL *active_file) {
+static void _reply_with_file(socketpool_socket_obj_t *socket, _request *request, const char *filename, FIL *active_file, const char *etag) {
     uint32_t total_length = f_size(active_file);
 
     _send_str(socket, "HTTP/1.1 200 OK\r\n");
     mp_print_t _socket_print = {socket, _print_raw};
     mp_printf(&_socket_print, "Content-Length: %d\r\n", total_length);
+    _send_strs(socket, "ETag: ", etag, "\r\n", NULL);
     // TODO: Make this a table to save space.
     if (_endswith(filename, ".txt") || _endswith(filename, ".py") || _endswith(filename, ".toml")) {
         _send_strs(socket, "Content-Type:", "text/plain", ";charset=UTF-8\r\n", NULL);
@@ -820,14 +973,19 @@ static void _reply_with_file(socketpool_socket_obj_t *socket, _request *request,
 
     uint32_t total_read = 0;
     int nodelay_ok = -1;
+    // Read whole sectors so that FatFs reads them straight into the buffer
+    // rather than through its window.
+    uint8_t data_buffer[FF_MIN_SS];
     while (total_read < total_length) {
-        uint8_t data_buffer[64];
         size_t quantity_read;
-        f_read(active_file, data_buffer, 64, &quantity_read);
+        FRESULT res = f_read(active_file, data_buffer, sizeof(data_buffer), &quantity_read);
+        if (res != FR_OK || quantity_read == 0) {
+            break;
+        }
         total_read += quantity_read;
         // When getting near the end of the file, disable Nagle's combining algorithm so that
         // data is sent immediately.
-        if (total_length - total_read < 64) {
+        if (total_length - total_read < sizeof(data_buffer) && nodelay_ok != 0) {
             int nodelay = 1;
             // Returns 0 when it works.
             nodelay_ok = common_hal_socketpool_socket_setsockopt(socket, SOCKETPOOL_IPPROTO_TCP, SOCKETPOOL_TCP_NODELAY, &nodelay, sizeof(nodelay));
@@ -1136,7 +1294,7 @@ static void _write_file_and_reply(socketpool_socket_obj_t *socket, _request *req
     }
 }
 
-#define STATIC_FILE(filename) extern uint32_t filename##_length; extern uint8_t filename[]; extern const char *filename##_content_type;
+#define STATIC_FILE(filename) extern uint32_t filename##_length; extern uint32_t filename##_uncompressed_length; extern uint8_t filename[]; extern const char *filename##_content_type;
 
 STATIC_FILE(code_html);
 STATIC_FILE(directory_html);
@@ -1150,25 +1308,72 @@ STATIC_FILE(serial_html);
 STATIC_FILE(serial_js);
 STATIC_FILE(blinka_32x32_ico);
 
-static void _reply_static(socketpool_socket_obj_t *socket, _request *request, const uint8_t *response, size_t response_len, const char *content_type) {
-    uint32_t total_length = response_len;
+static void _send_static_headers(socketpool_socket_obj_t *socket, const char *content_encoding, size_t length, const char *content_type) {
     char encoded_len[10];
-    snprintf(encoded_len, sizeof(encoded_len), "%" PRIu32, total_length);
+    snprintf(encoded_len, sizeof(encoded_len), "%" PRIu32, (uint32_t)length);
 
     _send_strs(socket,
         "HTTP/1.1 200 OK\r\n",
-        "Content-Encoding: gzip\r\n",
+        content_encoding,
         "Content-Length: ", encoded_len, "\r\n",
         "Content-Type: ", content_type, "\r\n",
         #if CIRCUITPY_DEBUG == 0
         "Cache-Control: max-age=31536000\r\n", // Cache for a year.
-        "Vary: Accept\r\n",
+        "Vary: Accept, Accept-Encoding\r\n",
         #endif
         "\r\n", NULL);
+}
+
+#if CIRCUITPY_ZLIB
+// The window tools/gen_web_workflow_static.py compresses with.
+#define STATIC_FILE_WINDOW_SIZE (1 << 11)
+
+typedef struct {
+    TINF_DATA decomp;
+    uint8_t dict[STATIC_FILE_WINDOW_SIZE];
+    uint8_t out[256];
+} _static_decompressor_t;
+
+static void _send_decompressed(socketpool_socket_obj_t *socket, _static_decompressor_t *decompressor, const uint8_t *response, size_t response_len) {
+    TINF_DATA *decomp = &decompressor->decomp;
+    memset(decomp, 0, sizeof(*decomp));
+    decomp->source = response;
+    decomp->source_limit = response + response_len;
+    int st = uzlib_gzip_parse_header(decomp);
+    uzlib_uncompress_init(decomp, decompressor->dict, sizeof(decompressor->dict));
+    while (st == TINF_OK) {
+        decomp->dest = decompressor->out;
+        decomp->dest_limit = decompressor->out + sizeof(decompressor->out);
+        st = uzlib_uncompress_chksum(decomp);
+        if (st < 0) {
+            // The length has already been sent, so all we can do is hang up.
+            socketpool_socket_close(socket);
+            return;
+        }
+        web_workflow_send_raw(socket, st == TINF_DONE, decompressor->out, decomp->dest - decompressor->out);
+    }
+}
+#endif
+
+static void _reply_static(socketpool_socket_obj_t *socket, _request *request, const uint8_t *response, size_t response_len, size_t uncompressed_len, const char *content_type) {
+    #if CIRCUITPY_ZLIB
+    // Files are stored gzipped. Decompress them for the rare client that
+    // can't, as long as there is memory to do it.
+    if (!request->accept_gzip) {
+        _static_decompressor_t *decompressor = port_malloc(sizeof(_static_decompressor_t), false);
+        if (decompressor != NULL) {
+            _send_static_headers(socket, "", uncompressed_len, content_type);
+            _send_decompressed(socket, decompressor, response, response_len);
+            port_free(decompressor);
+            return;
+        }
+    }
+    #endif
+    _send_static_headers(socket, "Content-Encoding: gzip\r\n", response_len, content_type);
     web_workflow_send_raw(socket, true, response, response_len);
 }
 
-#define _REPLY_STATIC(socket, request, filename) _reply_static(socket, request, filename, filename##_length, filename##_content_type)
+#define _REPLY_STATIC(socket, request, filename) _reply_static(socket, request, filename, filename##_length, filename##_uncompressed_length, filename##_content_type)
 
 static void _reply_websocket_upgrade(socketpool_socket_obj_t *socket, _request *request) {
     // Compute accept key
@@ -1379,16 +1584,31 @@ static bool _reply(socketpool_socket_obj_t *socket, _request *request) {
                 }
             } else { // Dealing with a file.
                 if (strcasecmp(request->method, "GET") == 0) {
+                    // FAT times only have two second resolution, and are fixed
+                    // without an RTC, so a same sized edit can keep both the
+                    // size and time. The filesystem's id and write count
+                    // change on every remount and write, so include them too.
+                    FILINFO file_info;
+                    FRESULT result = f_stat(fs, path, &file_info);
+                    char etag[40];
                     FIL active_file;
-                    FRESULT result = f_open(fs, &active_file, path, FA_READ);
+                    if (result == FR_OK) {
+                        snprintf(etag, sizeof(etag), "\"%x-%lx-%08lx-%lx\"",
+                            fs->id, (unsigned long)fs_mount->write_count,
+                            ((unsigned long)file_info.fdate << 16) | file_info.ftime, (unsigned long)file_info.fsize);
+                        if (strstr(request->if_none_match, etag) != NULL) {
+                            _reply_not_modified(socket, request, etag);
+                            return false;
+                        }
+                        result = f_open(fs, &active_file, path, FA_READ);
+                    }
 
                     if (result != FR_OK) {
                         _reply_missing(socket, request);
                     } else {
-                        _reply_with_file(socket, request, path, &active_file);
+                        _reply_with_file(socket, request, path, &active_file, etag);
+                        f_close(&active_file);
                     }
-
-                    f_close(&active_file);
                 } else if (strcasecmp(request->method, "PUT") == 0) {
                     _write_file_and_reply(socket, request, fs_mount, path);
                     return true;
@@ -1467,6 +1687,7 @@ static void _reset_request(_request *request) {
     request->state = STATE_METHOD;
     request->origin[0] = '\0';
     request->host[0] = '\0';
+    request->if_none_match[0] = '\0';
     request->content_length = 0;
     request->offset = 0;
     request->timestamp_ms = 0;
@@ -1477,6 +1698,7 @@ static void _reset_request(_request *request) {
     request->authenticated = false;
     request->expect = false;
     request->json = false;
+    request->accept_gzip = false;
     request->websocket = false;
 }
 
@@ -1583,9 +1805,14 @@ static void _process_request(socketpool_socket_obj_t *socket, _request *request)
                         request->expect = strcmp(request->header_value, "100-continue") == 0;
                     } else if (strcasecmp(request->header_key, "Accept") == 0) {
                         request->json = strcasecmp(request->header_value, "application/json") == 0;
+                    } else if (strcasecmp(request->header_key, "Accept-Encoding") == 0) {
+                        request->accept_gzip = strstr(request->header_value, "gzip") != NULL;
                     } else if (strcasecmp(request->header_key, "Origin") == 0) {
                         strncpy(request->origin, request->header_value, sizeof(request->origin) - 1);
                         request->origin[sizeof(request->origin) - 1] = '\0';
+                    } else if (strcasecmp(request->header_key, "If-None-Match") == 0) {
+                        strncpy(request->if_none_match, request->header_value, sizeof(request->if_none_match) - 1);
+                        request->if_none_match[sizeof(request->if_none_match) - 1] = '\0';
                     } else if (strcasecmp(request->header_key, "X-Timestamp") == 0) {
                         request->timestamp_ms = strtoull(request->header_value, NULL, 10);
                     } else if (strcasecmp(request->header_key, "Upgrade") == 0) {
@@ -1705,4 +1932,5 @@ void supervisor_web_workflow_background(void *data) {
 }
 
 void supervisor_stop_web_workflow(void) {
+    _clear_directory_cache();
 }
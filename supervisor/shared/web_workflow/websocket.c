@@ -227,7 +227,9 @@ void websocket_background(void) {
     while (ringbuf_num_empty(&_incoming_ringbuf) > 0 &&
            _read_next_payload_byte(&c)) {
         if (c == mp_interrupt_char) {
-            ringbuf_clear(&_incoming_ringbuf);
+            // The reader runs on the same thread, so it can't be partway
+            // through a get.
+            ringbuf_drop_pending(&_incoming_ringbuf);
             mp_sched_keyboard_interrupt();
             continue;
         }
@@ -0,0 +1,38 @@
+# CIRCUITPY-CHANGE: micropython does not have this file
+# test multiplication and str() of ints large enough to use the
+# divide-and-conquer algorithms, checking against simple identities
+
+# numbers with long runs of set and clear digits exercise carries
+x = (1 << 4000) - 1
+y = (1 << 3000) + 12345
+print(x * y == (y << 4000) - y)
+print(x * x == (1 << 8000) - (1 << 4001) + 1)
+
+# unbalanced operands
+z = 3**1000
+print(z * x == (z << 4000) - z)
+print(x * z == z * x)
+
+# signs
+print(-x * y == -(x * y), (-x) * (-y) == x * y)
+
+# products checked by division
+a = 7**1500
+b = 11**1200
+p = a * b
+print(p // a == b, p % a, p // b == a)
+
+# str() round trip, including zero runs that must be padded
+for n in (10**1000, 10**1000 - 1, 10**2000 + 1, 3**3000, -(7**1700), (1 << 5000) + 5):
+    s = str(n)
+    print(len(s), s[:20], s[-20:], int(s) == n)
+
+# other bases
+n = 3**2000
+print(hex(n)[-20:], int(hex(n), 16) == n)
+print(oct(n)[-20:], int(oct(n), 8) == n)
+print(bin(n)[-20:], int(bin(n), 2) == n)
+
+# thousands separator
+s = "{:,}".format(10**600 + 123456789)
+print(len(s), s[:8], s[-12:], int(s.replace(",", "")) == 10**600 + 123456789)
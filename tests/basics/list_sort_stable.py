@@ -0,0 +1,50 @@
+# test that list.sort() and sorted() are stable and call key once per item
+
+# records with equal keys must keep their original order
+records = [(i % 7, i) for i in range(100)]
+print(sorted(records, key=lambda r: r[0]) == [r for k in range(7) for r in records if r[0] == k])
+print(sorted(records, key=lambda r: r[0], reverse=True) == [r for k in range(6, -1, -1) for r in records if r[0] == k])
+
+# mostly sorted input, as when appending timestamped samples
+l = list(range(1000))
+l[100], l[900] = l[900], l[100]
+l.sort()
+print(l == list(range(1000)))
+
+# runs in both directions
+l = list(range(50)) + list(range(100, 50, -1)) + list(range(200, 150, -1))
+print(sorted(l) == sorted(l, key=lambda x: x))
+print(sorted(l, reverse=True)[:3])
+
+calls = 0
+
+
+def key(x):
+    global calls
+    calls += 1
+    return -x
+
+
+l = [i * 37 % 101 for i in range(101)]
+l.sort(key=key)
+print(calls, l[:5])
+
+# a comparison that raises leaves the list as a permutation of its items
+
+
+class C:
+    def __init__(self, v):
+        self.v = v
+
+    def __lt__(self, other):
+        if self.v == 50 or other.v == 50:
+            raise ValueError
+        return self.v < other.v
+
+
+l = [C(i) for i in range(100, 0, -1)]
+try:
+    l.sort()
+except ValueError:
+    print("ValueError")
+print(sorted(c.v for c in l) == list(range(1, 101)))
@@ -0,0 +1,25 @@
+# CIRCUITPY-CHANGE: micropython does not have this file
+# Strings built at runtime hash and compare the same as literals
+
+a = "ab" + "cd"
+print(a == "abcd", hash(a) == hash("abcd"), hash(a) == hash(a))
+d = {"abcd": 1, "long" * 100: 2}
+print(d[a], d["lo" + "ng" * 1 + "long" * 99])
+
+long = "x" * 300
+s = set()
+for i in range(3):
+    s.add(long[:-1] + "x")
+print(len(s), long in s, (long[:-1] + "x") in s)
+
+keys = ["key%d" % i + "_" * i for i in range(50)]
+d = {k: i for i, k in enumerate(keys)}
+print(all(d["key%d" % i + "_" * i] == i for i in range(50)))
+
+# io.StringIO as a string builder
+import io
+
+b = io.StringIO()
+for i in range(100):
+    b.write("%d," % i)
+print(len(b.getvalue()), b.getvalue()[-10:])
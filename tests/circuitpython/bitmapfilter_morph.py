@@ -39,3 +39,14 @@ dump_bitmap(b)
 b = make_circle_bitmap()
 bitmapfilter.morph(b, weights=sharpen, threshold=True, add=0.125, invert=True)
 dump_bitmap(b)
+
+# Separable kernels: a 5x5 box blur and a (signed) horizontal Sobel edge filter
+box = [1] * 25
+b = make_circle_bitmap()
+bitmapfilter.morph(b, weights=box)
+dump_bitmap(b)
+
+sobel = [-1, 0, 1, -2, 0, 2, -1, 0, 1]
+b = make_circle_bitmap()
+bitmapfilter.morph(b, weights=sobel, mul=1 / 4, add=0.5)
+dump_bitmap(b)
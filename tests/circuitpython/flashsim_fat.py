@@ -0,0 +1,118 @@
+# CIRCUITPY-CHANGE: micropython does not have this file
+
+# Replay FAT workloads on the supervisor's external flash layer, running on a
+# simulated flash, and report how much flash wear and time they cost.
+
+try:
+    import flashsim, os
+
+    os.VfsFat
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+MP_BLOCKDEV_IOCTL_SYNC = 3
+MP_BLOCKDEV_IOCTL_DEINIT = 2
+
+
+def copy(fs):
+    chunk = bytes(range(256)) * 2
+    with fs.open("/a.bin", "wb") as f:
+        for _ in range(64):
+            f.write(chunk)
+    buf = bytearray(256)
+    with fs.open("/a.bin", "rb") as src, fs.open("/b.bin", "wb") as dst:
+        while src.readinto(buf):
+            dst.write(buf)
+    return {"/a.bin": chunk * 64, "/b.bin": chunk * 64}
+
+
+def log(fs):
+    lines = []
+    for i in range(100):
+        line = "%04d,temperature,%d.%d\n" % (i, 20 + i % 7, i % 10)
+        with fs.open("/log.csv", "a") as f:
+            f.write(line)
+        lines.append(line)
+    return {"/log.csv": "".join(lines).encode()}
+
+
+def log_held_open(fs):
+    lines = []
+    with fs.open("/log.csv", "a") as f:
+        for i in range(400):
+            line = "%04d,temperature,%d.%d\n" % (i, 20 + i % 7, i % 10)
+            if i == 200:
+                # Longer than the buffer writes are gathered in.
+                line = "#" * 1500 + "\n"
+            f.write(line)
+            lines.append(line)
+            if i % 20 == 19:
+                f.flush()
+        if f.tell() != len("".join(lines)):
+            print("tell", f.tell())
+    return {"/log.csv": "".join(lines).encode()}
+
+
+def small_files(fs):
+    files = {}
+    fs.mkdir("/lib")
+    for i in range(30):
+        name = "/lib/m%02d.py" % i
+        data = ("x = %d\n" % i).encode() * 12
+        with fs.open(name, "wb") as f:
+            f.write(data)
+        files[name] = data
+    return files
+
+
+def run(name, workload, **config):
+    flashsim.init(**config)
+    os.VfsFat.mkfs(flashsim)
+    fs = os.VfsFat(flashsim)
+    flashsim.reset_stats()
+    files = workload(fs)
+    flashsim.ioctl(MP_BLOCKDEV_IOCTL_SYNC, 0)
+    stats = flashsim.stats()
+
+    # Check everything made it to the flash itself.
+    flashsim.ioctl(MP_BLOCKDEV_IOCTL_DEINIT, 0)
+    fs = os.VfsFat(flashsim)
+    ok = True
+    for path, data in files.items():
+        with fs.open(path, "rb") as f:
+            ok = ok and f.read() == data
+
+    written = sum(len(data) for data in files.values())
+    print(
+        name,
+        "erases/MB:",
+        stats["sector_erases"] * 1024 * 1024 // written,
+        "max wear:",
+        stats["max_region_erases"],
+        "ms/MB:",
+        stats["elapsed_us"] * 1024 // written,
+        "errors:",
+        stats["program_errors"],
+        "ok:",
+        ok,
+    )
+
+
+for name, workload in (
+    ("copy", copy),
+    ("log", log),
+    ("log held open", log_held_open),
+    ("small files", small_files),
+):
+    run(name, workload)
+    # No ram for a cache, so the scratch sector is used.
+    run(name + " (no ram)", workload, ram=0)
+
+# A device with bigger pages is written the same way.
+run("copy (512 byte pages)", copy, page_size=512)
+
+try:
+    flashsim.init(erase_size=1000)
+except ValueError:
+    print("ValueError")
@@ -0,0 +1,59 @@
+# CIRCUITPY-CHANGE: micropython does not have this file
+# Test that TaskQueue returns tasks in deadline order, then in the order pushed,
+# for deadlines near and far, and across the ticks wrap-around.
+
+try:
+    import _asyncio
+    import time
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+_TICKS_PERIOD = 1 << 29
+
+
+def key(base, offset):
+    return (base + offset) % _TICKS_PERIOD
+
+
+def check(base, offsets):
+    q = _asyncio.TaskQueue()
+    tasks = []
+    for i, offset in enumerate(offsets):
+        t = _asyncio.Task(None)
+        q.push(t, key(base, offset))
+        tasks.append((offset, i, t))
+    # Remove every fifth task.
+    for offset, i, t in tasks[::5]:
+        q.remove(t)
+    expected = sorted(tasks[i] for i in range(len(tasks)) if i % 5)
+    got = []
+    while q.peek() is not None:
+        t = q.pop()
+        got.append(t)
+    print(len(got), got == [t for offset, i, t in expected])
+
+
+now = time.ticks_ms() & (_TICKS_PERIOD - 1)
+offsets = [(i * 37) % 50 for i in range(60)]
+offsets += [(i * 7919) % 40000 for i in range(60)]
+offsets += [-(i % 20) for i in range(20)]
+offsets += [2000000] * 5 + [0] * 5
+check(now, offsets)
+check(_TICKS_PERIOD - 1000, offsets)
+
+# Pop in between pushes, as the scheduler does.
+q = _asyncio.TaskQueue()
+order = []
+for i in range(10):
+    t = _asyncio.Task(None)
+    q.push(t, key(now, 100 * (i % 3)))
+    order.append(t)
+first = q.pop()
+q.push(first, key(now, 100))
+print([order.index(q.pop()) for i in range(10)])
+
+try:
+    q.pop()
+except IndexError:
+    print("IndexError")
@@ -0,0 +1,64 @@
+# CIRCUITPY-CHANGE: micropython does not have this file
+# Test json.iterload, which yields the items of one container at a time.
+
+try:
+    from io import StringIO
+    import json
+
+    json.iterload
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+doc = """{"meta": {"page": 1, "note": "a \\"quoted\\" ] string", "n": [1, {"x": []}]},
+ "data": {"items": [{"id": 1}, {"id": 2, "tags": ["a", "b"]}, 3.5, null, "s"],
+          "more": {"k": true, "l": [1, 2]}},
+ "last": [[1], [2, 3]]}"""
+
+for item in json.iterload(StringIO(doc), ("data", "items")):
+    print(item)
+for item in json.iterload(StringIO(doc), path=["data", "more"]):
+    print(item)
+for item in json.iterload(StringIO(doc), ("last", 1)):
+    print(item)
+print(list(json.iterload(StringIO("[]"))))
+print(list(json.iterload(StringIO('[1, "2", [3]]'))))
+print(list(json.iterload(StringIO("{}"))))
+
+# The stream is left just after the container.
+s = StringIO("[1, 2] [3]")
+print(list(json.iterload(s)), json.load(s))
+
+# Missing path elements.
+for path in (("nope",), ("data", 0), ("last", 2), ("last", -1)):
+    try:
+        json.iterload(StringIO(doc), path)
+    except KeyError as e:
+        print("KeyError", e)
+
+# Not a container.
+try:
+    json.iterload(StringIO(doc), ("meta", "page"))
+except TypeError:
+    print("TypeError")
+
+# Malformed input.
+for text in ("", "[1, 2", '{"a" 1 2}', '{"a": '):
+    try:
+        print(list(json.iterload(StringIO(text))))
+    except ValueError:
+        print("ValueError")
+
+# Any object with readinto can be read from.
+class Buffer:
+    def __init__(self, data):
+        self._data = data
+        self._i = 0
+
+    def readinto(self, buf):
+        n = min(len(buf), len(self._data) - self._i)
+        buf[:n] = self._data[self._i : self._i + n]
+        self._i += n
+        return n
+
+print(list(json.iterload(Buffer(doc.encode()), ("meta", "n"))))
@@ -0,0 +1,22 @@
+# CIRCUITPY-CHANGE: micropython does not have this file
+# Test that json.load leaves a stream positioned just after the object it read,
+# so further objects or other data can follow.
+
+try:
+    from io import StringIO
+    import json
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+s = StringIO('{"a": [1, 2]} [3]\n"x" tail')
+print(json.load(s))
+print(json.load(s))
+print(json.load(s))
+print(repr(s.read()))
+
+# An object longer than the read buffer.
+s = StringIO('{"k": "' + "v" * 1000 + '"}\n12 rest')
+print(len(json.load(s)["k"]))
+print(json.load(s))
+print(repr(s.read()))
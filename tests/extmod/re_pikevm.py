@@ -0,0 +1,64 @@
+# CIRCUITPY-CHANGE: micropython does not have this file
+# Test that the Pike VM engine finds the same matches as the backtracking one.
+
+try:
+    import re
+
+    re.PIKEVM
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+tests = (
+    ("a", "xaz"),
+    ("a*", "aaab"),
+    ("a*?", "aaab"),
+    ("a+?b", "aaab"),
+    ("a??a", "a"),
+    ("(a|ab)(c|bcd)(d*)", "abcd"),
+    ("(ab|a)(bc|c)?", "abc"),
+    ("^(\\w+)\\s*=\\s*(\\d+)$", "key = 42"),
+    ("(\\d+)-(\\d+)", "tel: 555-1234 ok"),
+    ("[^,]*,([a-c]+)", "xyz,abcd,e"),
+    ("(?:x|y)+z", "xyxyz"),
+    ("(a)|(b)", "b"),
+    ("$", "abc"),
+    ("^$", ""),
+    ("c$", "abc"),
+    ("(.*)(\\.)(.*)", "a.b.c"),
+    ("q", "abc"),
+)
+
+
+def groups(m):
+    g = []
+    try:
+        while True:
+            g.append(m.group(len(g)))
+    except IndexError:
+        return g
+
+
+for pattern, subject in tests:
+    r1 = re.compile(pattern)
+    r2 = re.compile(pattern, re.PIKEVM)
+    for f in ("match", "search"):
+        m1 = getattr(r1, f)(subject)
+        m2 = getattr(r2, f)(subject)
+        if m1 is None or m2 is None:
+            print(pattern, f, m1 is None, m2 is None)
+        else:
+            g1 = groups(m1)
+            g2 = groups(m2)
+            print(pattern, f, g1 == g2, g2)
+
+r = re.compile(",", re.PIKEVM)
+print(r.split("a,b,,c"))
+print(re.compile("(b)", re.PIKEVM).sub("[\\1]", "abcb"))
+
+# Patterns with nested repeats use the Pike VM automatically, so they neither
+# take exponential time nor run out of stack.
+print(re.match("(a+)+b", "a" * 40))
+print(re.search("(x+x+)+y", "x" * 40))
+print(re.match("(a|aa)*c", "a" * 60 + "c").group(0) == "a" * 60 + "c")
+print(re.match("(a*)*", "a" * 1000).group(0) == "a" * 1000)
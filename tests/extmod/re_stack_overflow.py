@@ -4,6 +4,12 @@ except ImportError:
     print("SKIP")
     raise SystemExit
 
+# CIRCUITPY-CHANGE: the Pike VM runs this pattern without recursing; see
+# re_stack_overflow_pikevm.py
+if hasattr(re, "PIKEVM"):
+    print("SKIP")
+    raise SystemExit
+
 try:
     re.match("(a*)*", "aaa")
 except RuntimeError:
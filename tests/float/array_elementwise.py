@@ -0,0 +1,34 @@
+# CIRCUITPY-CHANGE: micropython does not have this file
+# test elementwise arithmetic methods of float arrays
+
+try:
+    from array import array
+
+    array("f").add
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+a = array("f", [1, 2, 3, 4])
+a.add(1)
+print(a)
+a.mul(array("f", [2, 2, 2, 2]))
+print(a)
+a.add(array("h", [-1, -2, -3, -4]))
+print(a)
+a.scale(0.5, 1)
+print(a)
+a.clip(2, 3.5)
+print(a)
+print(a.sum(), a.dot(a), array("h", [1, 2, 3]).sum(), array("B", [1, 2]).dot(bytearray([3, 4])))
+d = array("d", range(5))
+d.mul(d)
+print(d, d.sum())
+try:
+    array("i", [1]).add(1)
+except TypeError:
+    print("TypeError")
+try:
+    a.add(array("f", [1]))
+except ValueError:
+    print("ValueError")
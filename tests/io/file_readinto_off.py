@@ -0,0 +1,18 @@
+# CIRCUITPY-CHANGE: micropython does not have this file
+# readinto(buf, off, max_len) fills part of buf, like write(buf, off, max_len)
+b = bytearray(12)
+f = open("data/file1", "rb")
+print(f.readinto(b, 2, 4))
+print(b)
+print(f.readinto(b, 8, 100))
+print(b)
+print(f.readinto(b, 20, 4))
+f.close()
+
+import io
+
+f = io.BytesIO(b"0123456789")
+b = bytearray(6)
+m = memoryview(b)
+print(f.readinto(m, 1, 3), b)
+print(f.readinto(m, 4, 3), b)
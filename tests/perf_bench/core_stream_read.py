@@ -0,0 +1,60 @@
+# CIRCUITPY-CHANGE: micropython does not have this file
+# This tests reading fixed-size frames from a stream into a reused buffer,
+# as protocol code for a UART or USB serial link does.
+
+import io
+
+FRAME = 16
+
+try:
+    io.BytesIO().readinto(bytearray(1), 0, 1)
+
+    def readinto(f, buf, off, n):
+        return f.readinto(buf, off, n)
+
+except TypeError:
+    # CPython can only read into a slice.
+    def readinto(f, buf, off, n):
+        return f.readinto(memoryview(buf)[off : off + n])
+
+
+def test(niter, data):
+    buf = bytearray(4 * FRAME)
+    total = 0
+    for _ in range(niter):
+        f = io.BytesIO(data)
+        slot = 0
+        while readinto(f, buf, slot * FRAME, FRAME) == FRAME:
+            total += buf[slot * FRAME]
+            slot = (slot + 1) & 3
+        f.seek(0)
+        total += len(f.read())
+    return total
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (32, 10): (2, 1024),
+    (50, 10): (4, 1024),
+    (100, 10): (8, 2048),
+    (500, 10): (16, 4096),
+    (1000, 10): (32, 4096),
+    (5000, 10): (64, 8192),
+}
+
+
+def bm_setup(params):
+    niter, size = params
+    data = bytes(i & 0xFF for i in range(size))
+    state = None
+
+    def run():
+        nonlocal state
+        state = test(niter, data)
+
+    def result():
+        return niter * size, state
+
+    return run, result
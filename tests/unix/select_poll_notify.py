@@ -0,0 +1,69 @@
+# Test select.poll with native streams that notify when they may be ready.
+
+try:
+    PollNotifyStream
+    import select
+except (NameError, ImportError):
+    print("SKIP")
+    raise SystemExit
+
+POLLNVAL = 0x20
+
+a = PollNotifyStream()
+b = PollNotifyStream()
+names = {id(a): "a", id(b): "b"}
+
+
+def poll(p):
+    print(sorted((names[id(obj)], events) for obj, events in p.poll(0)))
+
+
+p = select.poll()
+p.register(a, select.POLLIN)
+p.register(b, select.POLLIN | select.POLLOUT)
+
+# nothing ready: each stream is polled once, then waits for a notification
+poll(p)
+poll(p)
+print(a.poll_count(), b.poll_count())
+
+# a notification makes the stream get polled again
+a.set_ready(select.POLLIN)
+poll(p)
+print(a.poll_count(), b.poll_count())
+
+# a ready stream stays polled until it reports nothing
+poll(p)
+a.set_ready(0)
+poll(p)
+poll(p)
+print(a.poll_count(), b.poll_count())
+
+# only the events asked for are reported
+b.set_ready(select.POLLIN | select.POLLOUT)
+p.modify(b, select.POLLOUT)
+poll(p)
+b.set_ready(0)
+poll(p)
+
+# more notifications than are kept: everything registered is polled again
+a.set_ready(select.POLLIN)
+for _ in range(20):
+    b.set_ready(0)
+before = b.poll_count()
+poll(p)
+print(b.poll_count() - before)
+a.set_ready(0)
+poll(p)
+
+# closing a waiting stream reports POLLNVAL
+a.close()
+print(p.poll(0) == [(a, POLLNVAL)])
+
+# unregistered streams are not polled after notifying
+p.unregister(a)
+p.unregister(b)
+before = b.poll_count()
+b.set_ready(select.POLLIN)
+poll(p)
+print(b.poll_count() - before)
@@ -179,8 +179,7 @@ const displayio_bitmap_t blinka_bitmap = {{
 
 _displayio_color_t blinka_colors[7] = {{
     {{
-        .rgb888 = 0x000000,
-        .transparent = true
+        .rgb888 = 0x000000
     }},
     {{ // Purple
         .rgb888 = 0x8428bc
@@ -202,9 +201,13 @@ _displayio_color_t blinka_colors[7] = {{
     }},
 }};
 
+// Color 0 is transparent.
+uint32_t blinka_transparent[1] = {{ 0x00000001 }};
+
 displayio_palette_t blinka_palette = {{
     .base = {{.type = &displayio_palette_type }},
     .colors = blinka_colors,
+    .transparent = blinka_transparent,
     .color_count = 7,
     .needs_refresh = false
 }};
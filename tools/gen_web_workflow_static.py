@@ -3,11 +3,15 @@
 # SPDX-License-Identifier: MIT
 
 import argparse
-import gzip
 import minify_html
 import jsmin
 import mimetypes
 import pathlib
+import zlib
+
+# Clients that don't accept gzip get the files decompressed on the device, which
+# needs a buffer the size of the window. Keep in sync with web_workflow.c.
+WINDOW_BITS = 11
 
 parser = argparse.ArgumentParser(description="Generate displayio resources.")
 parser.add_argument("--output_c_file", type=argparse.FileType("w"), required=True)
@@ -32,7 +36,9 @@ for f in args.files:
         uncompressed = jsmin.jsmin(uncompressed.decode("utf-8"), quote_chars="'\"`").encode(
             "utf-8"
         )
-    compressed = gzip.compress(uncompressed)
+    minified_length = len(uncompressed)
+    compressor = zlib.compressobj(9, zlib.DEFLATED, 16 + WINDOW_BITS, 9)
+    compressed = compressor.compress(uncompressed) + compressor.flush()
     clen = len(compressed)
     compressed = ", ".join([hex(x) for x in compressed])
     mime = mimetypes.guess_type(f.name)[0]
@@ -40,5 +46,6 @@ for f in args.files:
     c_file.write(f"// {f.name}\n")
     c_file.write(f"// Original length: {ulen} Compressed length: {clen}\n")
     c_file.write(f"const uint32_t {variable}_length = {clen};\n")
+    c_file.write(f"const uint32_t {variable}_uncompressed_length = {minified_length};\n")
     c_file.write(f'const char* {variable}_content_type = "{mime}";\n')
     c_file.write(f"const uint8_t {variable}[{clen}] = {{{compressed}}};\n\n")